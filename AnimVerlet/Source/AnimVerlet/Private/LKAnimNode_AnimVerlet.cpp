@@ -1,15 +1,20 @@
 #include "LKAnimNode_AnimVerlet.h"
 
 #include <AnimationRuntime.h>
+#include <Animation/AnimInstance.h>
 #include <Animation/AnimInstanceProxy.h>
 #include <Animation/AnimTypes.h>
 #include <DrawDebugHelpers.h>
 #include <Kismet/KismetSystemLibrary.h>
 #include <PhysicsEngine/PhysicsAsset.h>
+#include <ProfilingDebugging/CpuProfilerTrace.h>
 #if (ENGINE_MINOR_VERSION >= 5)
 #include <PhysicsEngine/SkeletalBodySetup.h>
+#include <UObject/UnrealType.h>
 #endif
 #include "LKAnimVerletCollisionData.h"
+#include "LKAnimVerletConstraintUtil.h"
+#include "LKAnimVerletTopologyAsset.h"
 
 #if LK_ENABLE_ANIMVERLET_DEBUG
 static TAutoConsoleVariable<bool> CVarAnimNodeAnimVerletEnable(TEXT("a.AnimNode.AnimVerlet.Enable"), true, TEXT("Enable/Disable AnimVerlet"));
@@ -23,11 +28,18 @@ static TAutoConsoleVariable<bool> CVarAnimNodeAnimVerletDebugCapsuleCollision(TE
 ///static TAutoConsoleVariable<bool> CVarAnimNodeAnimVerletDebugBoxCollision(TEXT("a.AnimNode.AnimVerlet.Debug.BoxCollision"), true, TEXT("Turn on visualization debugging for AnimVerlet`s Box collision constraints"));
 #endif
 
+DECLARE_CYCLE_STAT(TEXT("AnimVerlet_BuildSimulationTopology"), STAT_AnimVerlet_BuildSimulationTopology, STATGROUP_Anim);
+DECLARE_CYCLE_STAT(TEXT("AnimVerlet_ActivateSimulationTopology"), STAT_AnimVerlet_ActivateSimulationTopology, STATGROUP_Anim);
+DECLARE_CYCLE_STAT(TEXT("AnimVerlet_LoadTopologyAsset"), STAT_AnimVerlet_LoadTopologyAsset, STATGROUP_Anim);
+DECLARE_CYCLE_STAT(TEXT("AnimVerlet_WaitAsyncTopologyBuild"), STAT_AnimVerlet_WaitAsyncTopologyBuild, STATGROUP_Anim);
 DECLARE_CYCLE_STAT(TEXT("AnimVerlet_PrepareSimulation"), STAT_AnimVerlet_PrepareSimulation, STATGROUP_Anim);
 DECLARE_CYCLE_STAT(TEXT("AnimVerlet_PrepareLocalCollisionConstraints"), STAT_AnimVerlet_PrepareLocalCollisionConstraints, STATGROUP_Anim);
 DECLARE_CYCLE_STAT(TEXT("AnimVerlet_SimulateVerlet"), STAT_AnimVerlet_SimulateVerlet, STATGROUP_Anim);
+DECLARE_CYCLE_STAT(TEXT("AnimVerlet_PrepareFrameUpdateParam"), STAT_AnimVerlet_PrepareFrameUpdateParam, STATGROUP_Anim);
 DECLARE_CYCLE_STAT(TEXT("AnimVerlet_PreUpdateBones"), STAT_AnimVerlet_PreUpdateBones, STATGROUP_Anim);
 DECLARE_CYCLE_STAT(TEXT("AnimVerlet_UpdateBroadphase"), STAT_AnimVerlet_UpdateBroadphase, STATGROUP_Anim);
+DECLARE_CYCLE_STAT(TEXT("AnimVerlet_UpdateWindComponentCache"), STAT_AnimVerlet_UpdateWindComponentCache, STATGROUP_Anim);
+DECLARE_CYCLE_STAT(TEXT("AnimVerlet_UpdateWorldGroundPlane"), STAT_AnimVerlet_UpdateWorldGroundPlane, STATGROUP_Anim);
 DECLARE_CYCLE_STAT(TEXT("AnimVerlet_SolveConstraints"), STAT_AnimVerlet_SolveConstraints, STATGROUP_Anim);
 DECLARE_CYCLE_STAT(TEXT("AnimVerlet_SolveConstraints_PinConstraints"), STAT_AnimVerlet_SolveConstraints_PinConstraints, STATGROUP_Anim);
 DECLARE_CYCLE_STAT(TEXT("AnimVerlet_SolveConstraints_DistanceConstraints"), STAT_AnimVerlet_SolveConstraints_DistanceConstraints, STATGROUP_Anim);
@@ -43,19 +55,65 @@ DECLARE_CYCLE_STAT(TEXT("AnimVerlet_SolveConstraints_PlaneCollisionConstraints")
 DECLARE_CYCLE_STAT(TEXT("AnimVerlet_SolveConstraints_WorldCollisionConstraints"), STAT_AnimVerlet_SolveConstraints_WorldCollisionConstraints, STATGROUP_Anim);
 DECLARE_CYCLE_STAT(TEXT("AnimVerlet_SolveConstraints_SelfCollisionConstraints"), STAT_AnimVerlet_SolveConstraints_SelfCollisionConstraints, STATGROUP_Anim);
 DECLARE_CYCLE_STAT(TEXT("AnimVerlet_SolveConstraints_FixedDistanceConstraints"), STAT_AnimVerlet_SolveConstraints_FixedDistanceConstraints, STATGROUP_Anim);
-DECLARE_CYCLE_STAT(TEXT("AnimVerlet_UpdateSleep"), STAT_AnimVerlet_UpdateSleep, STATGROUP_Anim);
 DECLARE_CYCLE_STAT(TEXT("AnimVerlet_PostUpdateBones"), STAT_AnimVerlet_PostUpdateBones, STATGROUP_Anim);
+DECLARE_CYCLE_STAT(TEXT("AnimVerlet_UpdateProceduralSway"), STAT_AnimVerlet_UpdateProceduralSway, STATGROUP_Anim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AnimVerlet_BonePasses"), STAT_AnimVerlet_BonePasses, STATGROUP_Anim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AnimVerlet_SleepingIslands"), STAT_AnimVerlet_SleepingIslands, STATGROUP_Anim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AnimVerlet_SkippedSleepingSteps"), STAT_AnimVerlet_SkippedSleepingSteps, STATGROUP_Anim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AnimVerlet_SleepingBones"), STAT_AnimVerlet_SleepingBones, STATGROUP_Anim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AnimVerlet_SimulatedBones"), STAT_AnimVerlet_SimulatedBones, STATGROUP_Anim);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("AnimVerlet_SleepingBoneFraction"), STAT_AnimVerlet_SleepingBoneFraction, STATGROUP_Anim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AnimVerlet_SleepingResultCacheHits"), STAT_AnimVerlet_SleepingResultCacheHits, STATGROUP_Anim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AnimVerlet_SkippedUpdateFrames"), STAT_AnimVerlet_SkippedUpdateFrames, STATGROUP_Anim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AnimVerlet_Share_FollowerNodes"), STAT_AnimVerlet_Share_FollowerNodes, STATGROUP_Anim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AnimVerlet_PendingInitializations"), STAT_AnimVerlet_PendingInitializations, STATGROUP_Anim);
 DECLARE_CYCLE_STAT(TEXT("AnimVerlet_ApplyResult"), STAT_AnimVerlet_ApplyResult, STATGROUP_Anim);
 
 static constexpr float LKG_MINFPS = 30.0f;
 static constexpr float LKG_MAXFPS = 500.0f;
 
+/// Natural frequency range(Hz) of the procedural sway spring, mapped from Stiffness
+static constexpr float LKG_SWAY_MIN_FREQUENCY = 0.5f;
+static constexpr float LKG_SWAY_MAX_FREQUENCY = 3.0f;
+static constexpr float LKG_SWAY_MIN_DAMPING_RATIO = 0.05f;
+
+namespace LkAnimVerlet
+{
+	/// Closed-form step of x'' = -w^2(x - Target) - 2zw x' with a constant target during the step. Stable for any delta time.
+	void StepSpringDamper(IN OUT FVector& InOutOffset, IN OUT FVector& InOutVelocity, const FVector& Target, float Omega, float Zeta, float InDeltaTime)
+	{
+		const FVector Y0 = InOutOffset - Target;
+		const FVector V0 = InOutVelocity;
+		const float Decay = FMath::Exp(-Zeta * Omega * InDeltaTime);
+		if (Zeta >= 1.0f - KINDA_SMALL_NUMBER)
+		{
+			/// Critically damped
+			const FVector C = V0 + Y0 * Omega;
+			InOutOffset = Target + (Y0 + C * InDeltaTime) * Decay;
+			InOutVelocity = (V0 - C * (Omega * InDeltaTime)) * Decay;
+			return;
+		}
+
+		const float DampedOmega = Omega * FMath::Sqrt(1.0f - Zeta * Zeta);
+		float SinT = 0.0f;
+		float CosT = 1.0f;
+		FMath::SinCos(&SinT, &CosT, DampedOmega * InDeltaTime);
+		InOutOffset = Target + (Y0 * CosT + (V0 + Y0 * (Zeta * Omega)) * (SinT / DampedOmega)) * Decay;
+		InOutVelocity = (V0 * CosT - (Y0 * (Omega * Omega) + V0 * (Zeta * Omega)) * (SinT / DampedOmega)) * Decay;
+	}
+}
+
 FLKAnimNode_AnimVerlet::FLKAnimNode_AnimVerlet()
 	: FAnimNode_SkeletalControlBase()
 {
 
 }
 
+FLKAnimNode_AnimVerlet::~FLKAnimNode_AnimVerlet()
+{
+	CancelAsyncTopologyBuild();
+}
+
 void FLKAnimNode_AnimVerlet::Initialize_AnyThread(const FAnimationInitializeContext& Context)
 {
 	FAnimNode_SkeletalControlBase::Initialize_AnyThread(Context);
@@ -72,6 +130,20 @@ void FLKAnimNode_AnimVerlet::Initialize_AnyThread(const FAnimationInitializeCont
 	InitializeBoneReferences(RequiredBones);
 
 	ClearSimulateBones();
+
+	/// Checked once here, where settings driven by pins still have their default values like in the bake
+	bTopologyAssetUpToDate = (TopologyAsset != nullptr && RequiredBones.IsValid() && 
+							  TopologyAsset->IsUpToDate(CalculateTopologySettingsHash(), CalculateTopologySkeletonHash(RequiredBones)));
+
+	/// Start building ahead of the first evaluation. The build uses the LOD overrides of the current LOD so the first evaluation does not rebuild it.
+	if (InitializationMode == ELKAnimVerletInitializationMode::Async && bActivate && RequiredBones.IsValid() && bTopologyAssetUpToDate == false)
+	{
+		bool bChainCollisionShapeChanged = false;
+		bool bChainResolutionChanged = false;
+		CachedSimulationLOD = Context.AnimInstanceProxy->GetLODLevel();
+		ApplyLODFeatureOverrides(CachedSimulationLOD, OUT bChainCollisionShapeChanged, OUT bChainResolutionChanged);
+		LaunchAsyncTopologyBuild(RequiredBones);
+	}
 }
 
 void FLKAnimNode_AnimVerlet::ResetDynamics(ETeleportType InTeleportType)
@@ -105,37 +177,123 @@ void FLKAnimNode_AnimVerlet::EvaluateSkeletalControl_AnyThread(FComponentSpacePo
 	const int32 CurrentLOD = Output.AnimInstanceProxy->GetLODLevel();
 	if (CachedSimulationLOD != INDEX_NONE && CurrentLOD != CachedSimulationLOD && bRebuildSimulationOnLODChange && SimulateBones.Num() > 0)
 		bPendingSimulationLODRebuild = true;
+	bool bChainCollisionShapeChanged = false;
+	bool bChainResolutionChanged = false;
+	if (CurrentLOD != CachedSimulationLOD)
+	{
+		/// The cached compact pose indexes belong to the previous LOD
+		bHasSleepingResultCache = false;
+		ApplyLODFeatureOverrides(CurrentLOD, OUT bChainCollisionShapeChanged, OUT bChainResolutionChanged);
+	}
 	CachedSimulationLOD = CurrentLOD;
 
+	/// A different chain resolution changes the topology, so it always needs a rebuild
+	if (bChainResolutionChanged && SimulateBones.Num() > 0)
+		bPendingSimulationLODRebuild = true;
+
 	const FTransform CurComponentT = Output.AnimInstanceProxy->GetComponentTransform();
 	bool bInitializedThisFrame = false;
 	if (bPendingSimulationLODRebuild)
 	{
-		if (bRebuildSimulationOnLODChange && SimulateBones.Num() > 0)
+		if ((bRebuildSimulationOnLODChange || bChainResolutionChanged) && SimulateBones.Num() > 0)
 		{
 			RebuildSimulationForLOD(Output, BoneContainer);
 			PrevComponentT = CurComponentT;
 		}
 		bPendingSimulationLODRebuild = false;
 	}
+	else if (bChainCollisionShapeChanged && SimulateBones.Num() > 0)
+	{
+		RebuildChainCollisionConstraints(Output, BoneContainer);
+		ActiveLODTopologyKey = MakeLODTopologyKey();
+	}
 
 	if (SimulateBones.Num() == 0)
 	{
-		InitializeSimulateBones(Output, BoneContainer);
+		/// Pass the pose through until the simulation is ready
+		const bool bLoadedTopologyAsset = (bTopologyAssetUpToDate && LoadTopologyAsset(Output, BoneContainer));
+		if (bLoadedTopologyAsset == false && InitializationMode == ELKAnimVerletInitializationMode::Async)
+		{
+			if (AsyncTopologyBuilder.IsValid() == false)
+				LaunchAsyncTopologyBuild(BoneContainer);
+			if (AsyncTopologyTask.IsCompleted() == false)
+			{
+				INC_DWORD_STAT(STAT_AnimVerlet_PendingInitializations);
+				return;
+			}
+			ActivateAsyncTopology(Output, BoneContainer);
+		}
+		else if (bLoadedTopologyAsset == false && InitializationMode == ELKAnimVerletInitializationMode::TimeSliced && LKAnimVerletBudgetScheduler::Get().TryAcquireInitialization() == false)
+		{
+			INC_DWORD_STAT(STAT_AnimVerlet_PendingInitializations);
+			return;
+		}
+
+		/// A stale async build or topology asset falls back to building on this frame
+		if (SimulateBones.Num() == 0)
+			InitializeSimulateBones(Output, BoneContainer);
+		ActiveLODTopologyKey = MakeLODTopologyKey();
 		PrevComponentT = CurComponentT;
 		bInitializedThisFrame = true;
 	}
 
+	/// Switching between procedural sway and the full simulation blends from the last result of the previous mode
+	if (bProceduralSwayActive != bLODUseProceduralSway)
+	{
+		if (bInitializedThisFrame == false)
+			BeginOutputBlendFromCurrentResult();
+		if (bLODUseProceduralSway == false)
+			WakeUpSleepIslands();
+		bProceduralSwayActive = bLODUseProceduralSway;
+		bProceduralSwayStateValid = false;
+	}
+
 	const USkeletalMeshComponent* SkeletalMeshComponent = Output.AnimInstanceProxy->GetSkelMeshComponent();
 	const UWorld* World = SkeletalMeshComponent->GetWorld();
 	bool bAdvanceOutputBlend = false;
 	float OutputBlendDeltaTime = 0.0f;
+
+	/// Followers of a share group apply the leader`s result and skip the simulation
+	if (bShareSimulationResult)
+	{
+		if (bInitializedThisFrame || ShareSettingsHash == 0)
+			ShareSettingsHash = CalculateShareSettingsHash();
+
+		const bool bWasShareLeader = bShareLeader;
+		bShareLeader = LKAnimVerletShareRegistry::Get().UpdateMember(IN OUT ShareHandle, MakeShareKey(Output, CurrentLOD, World));
+		if (bShareLeader == false)
+		{
+			ApplySharedResult(OUT OutBoneTransforms, Output, BoneContainer);
+			FixedStepAccumulator = 0.0f;
+			NumPendingSimulationSteps = 0;
+			PrevComponentT = CurComponentT;
+			return;
+		}
+
+		/// A promoted follower has no simulation history of its own
+		if (bWasShareLeader == false && bInitializedThisFrame == false)
+			bPendingDynamicsReset = true;
+	}
+	else
+	{
+		bShareLeader = true;
+	}
+
 	if (bUseWarmup == false)
 		bWarmupPending = false;
 
+	/// A fully sleeping node reapplies its cached result. Nothing can move, so the pending steps are dropped
+	const bool bUseCachedResult = (bInitializedThisFrame == false && bPendingDynamicsReset == false && bWarmupPending == false && bPause == false && bProceduralSwayActive == false
+								   && ApplySleepingResultCache(OUT OutBoneTransforms, Output, BoneContainer, CurComponentT));
+	if (bUseCachedResult)
+	{
+		FixedStepAccumulator = FMath::Max(FixedStepAccumulator - static_cast<float>(NumPendingSimulationSteps), 0.0f);
+		NumPendingSimulationSteps = 0;
+		PrevComponentT = CurComponentT;
+	}
 	/// Initialization and ResetPhysics only synchronize state on this frame.
 	/// Warmup is intentionally deferred until the next evaluated frame.
-	if (bInitializedThisFrame || bPendingDynamicsReset)
+	else if (bInitializedThisFrame || bPendingDynamicsReset)
 	{
 		/// Prepare each SimulateBones
 		PrepareSimulation(Output, BoneContainer, CurComponentT);
@@ -152,8 +310,12 @@ void FLKAnimNode_AnimVerlet::EvaluateSkeletalControl_AnyThread(FComponentSpacePo
 		PrepareSimulation(Output, BoneContainer, CurComponentT);
 		ResetSimulation();
 
+		UpdateWorldGeometryCache();
+		UpdateWorldGroundPlane(World, SkeletalMeshComponent);
+
 		const int32 ClampedWarmupStepCount = FMath::Max(WarmupStepCount, 0);
 		const float ClampedWarmupDeltaTime = FMath::Max(WarmupFixedDeltaTime, UE_SMALL_NUMBER);
+		PrepareFrameUpdateParam(CurComponentT, CurComponentT, 1);
 		for (int32 WarmupStep = 0; WarmupStep < ClampedWarmupStepCount; ++WarmupStep)
 		{
 			if (WarmupStep > 0)
@@ -162,15 +324,38 @@ void FLKAnimNode_AnimVerlet::EvaluateSkeletalControl_AnyThread(FComponentSpacePo
 			SimulateVerlet(World, ClampedWarmupDeltaTime, CurComponentT, CurComponentT);
 		}
 
+		/// Warmup ran with a still component, so its inertial delta must not be the previous delta of the first real step
+		bHasPrevInertialDiff = false;
 		bWarmupPending = false;
 		PrevComponentT = CurComponentT;
 		bAdvanceOutputBlend = true;
 		OutputBlendDeltaTime = DeltaTime;
 	}
+	/// Analytic spring-damper instead of the simulation(LODFeatureOverrides). The pending steps are merged into one closed-form step.
+	else if (bProceduralSwayActive && DeltaTime > 0.0f && NumPendingSimulationSteps > 0 && bPause == false)
+	{
+		const float SwayDeltaTime = DeltaTime * static_cast<float>(NumPendingSimulationSteps);
+		PrepareSimulateBonePoses(Output, BoneContainer, CurComponentT);
+		UpdateProceduralSway(SwayDeltaTime, CurComponentT, PrevComponentT);
+
+		FixedStepAccumulator = FMath::Max(FixedStepAccumulator - static_cast<float>(NumPendingSimulationSteps), 0.0f);
+		NumPendingSimulationSteps = 0;
+		PrevComponentT = CurComponentT;
+		bAdvanceOutputBlend = true;
+		OutputBlendDeltaTime = SwayDeltaTime;
+	}
 	/// Simulate verlet integration
 	else if (DeltaTime > 0.0f && NumPendingSimulationSteps > 0 && bPause == false)
 	{
+		const bool bReportBudgetCost = (BudgetHandle != INDEX_NONE && LKAnimVerletBudgetScheduler::IsEnabled());
+		TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(bReportBudgetCost ? LKAnimVerletBudgetScheduler::GetDecisionName(BudgetDecision) : TEXT("AnimVerlet_Simulate"));
+		const uint64 SimulateStartCycles = bReportBudgetCost ? FPlatformTime::Cycles64() : 0;
+
+		UpdateWorldGeometryCache();
+		UpdateWorldGroundPlane(World, SkeletalMeshComponent);
+
 		const int32 SimulationStepCount = NumPendingSimulationSteps;
+		PrepareFrameUpdateParam(CurComponentT, PrevComponentT, SimulationStepCount);
 		for (int32 SimulationStep = 0; SimulationStep < SimulationStepCount; ++SimulationStep)
 		{
 			const float PrevStepAlpha = static_cast<float>(SimulationStep) / static_cast<float>(SimulationStepCount);
@@ -182,6 +367,9 @@ void FLKAnimNode_AnimVerlet::EvaluateSkeletalControl_AnyThread(FComponentSpacePo
 
 			/// Prepare every fixed step so Verlet history advances correctly between substeps.
 			PrepareSimulation(Output, BoneContainer, CurStepComponentT);
+			/// Local colliders follow the animation pose, which is the same for every substep
+			if (SimulationStep == 0 && SleepIslands.Num() > 0)
+				WakeUpSleepIslandsNearMovingColliders();
 			SimulateVerlet(World, DeltaTime, CurStepComponentT, PrevStepComponentT);
 		}
 		FixedStepAccumulator = FMath::Max(FixedStepAccumulator - static_cast<float>(SimulationStepCount), 0.0f);
@@ -189,13 +377,31 @@ void FLKAnimNode_AnimVerlet::EvaluateSkeletalControl_AnyThread(FComponentSpacePo
 		PrevComponentT = CurComponentT;
 		bAdvanceOutputBlend = true;
 		OutputBlendDeltaTime = DeltaTime * static_cast<float>(SimulationStepCount);
+
+		if (bReportBudgetCost)
+		{
+			const float CostMs = static_cast<float>(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - SimulateStartCycles));
+			LKAnimVerletBudgetScheduler::Get().ReportCost(BudgetHandle, CostMs, BudgetDecision);
+		}
+	}
+	else if (ShouldHoldSimulation())
+	{
+		/// The held result rides along with the component. Do not turn the held time into inertia when the node resumes.
+		PrevComponentT = CurComponentT;
 	}
 
 	if (bAdvanceOutputBlend)
 		AdvanceOutputBlend(OutputBlendDeltaTime);
 
 	/// Apply simulation to bone
-	ApplyResult(OutBoneTransforms, Output, BoneContainer);
+	if (bUseCachedResult == false)
+	{
+		ApplyResult(OutBoneTransforms, Output, BoneContainer);
+		BuildSleepingResultCache(OutBoneTransforms, Output, BoneContainer);
+	}
+
+	if (bShareSimulationResult)
+		PublishSharedResult(OutBoneTransforms, Output);
 
 #if LK_ENABLE_ANIMVERLET_DEBUG
 	if (CVarAnimNodeAnimVerletDebug.GetValueOnAnyThread())
@@ -228,6 +434,14 @@ void FLKAnimNode_AnimVerlet::InitializeBoneReferences(const FBoneContainer& Requ
 		CurConstraintSetting.BoneB.Initialize(RequiredBones);
 	}
 
+	/// Required bones changed, so the compact pose indexes of the cached result are stale
+	bHasSleepingResultCache = false;
+
+	InitializeSimulationBoneReferences(RequiredBones);
+}
+
+void FLKAnimNode_AnimVerlet::InitializeSimulationBoneReferences(const FBoneContainer& RequiredBones)
+{
 	for (int32 i = 0; i < SimulateBones.Num(); ++i)
 	{
 		SimulateBones[i].BoneReference.Initialize(RequiredBones);
@@ -299,11 +513,50 @@ void FLKAnimNode_AnimVerlet::UpdateInternal(const FAnimationUpdateContext& Conte
 {
 	FAnimNode_SkeletalControlBase::UpdateInternal(Context);
 
+	UpdateSignificanceLOD();
+	ApplyBudgetDecision();
+	ApplyOffscreenThrottle();
 	UpdateDeltaTime(Context.GetDeltaTime() * PlaySpeedRate, Context.AnimInstanceProxy != nullptr ? Context.AnimInstanceProxy->GetTimeDilation() * PlaySpeedRate : PlaySpeedRate);
 }
 
+bool FLKAnimNode_AnimVerlet::HasPreUpdate() const
+{
+	const bool bUseAsyncWorldQuery = (WorldCollisionProfile != NAME_None && bUseAsyncWorldCollision && bUseWorldGeometryCache == false);
+	return (bUseAsyncWorldQuery || bAdjustWindComponent || bUseSignificanceLOD || bUseBudgetScheduler || OffscreenMode != ELKAnimVerletOffscreenMode::Simulate);
+}
+
+void FLKAnimNode_AnimVerlet::PreUpdate(const UAnimInstance* InAnimInstance)
+{
+	FAnimNode_SkeletalControlBase::PreUpdate(InAnimInstance);
+
+	/// Game thread, before this frame's evaluation: consume last frame's async world sweeps and queue the next batch
+	if (bLODAllowWorldCollision)
+	{
+		for (FLKAnimVerletConstraint_World& CurConstraint : WorldCollisionConstraints)
+			CurConstraint.UpdateAsyncQueries_GameThread();
+	}
+
+	/// Scene wind lookups iterate every wind source, so sample them here once per frame instead of per bone and substep on the worker
+	UpdateWindComponentCache_GameThread(InAnimInstance != nullptr ? InAnimInstance->GetSkelMeshComponent() : nullptr);
+
+	/// View locations are only available on the game thread
+	UpdateSignificance_GameThread(InAnimInstance != nullptr ? InAnimInstance->GetSkelMeshComponent() : nullptr);
+	UpdateBudget_GameThread(InAnimInstance != nullptr ? InAnimInstance->GetSkelMeshComponent() : nullptr);
+	UpdateOffscreen_GameThread(InAnimInstance != nullptr ? InAnimInstance->GetSkelMeshComponent() : nullptr);
+}
+
 void FLKAnimNode_AnimVerlet::InitializeSimulateBones(FComponentSpacePoseContext& PoseContext, const FBoneContainer& BoneContainer)
 {
+	BuildSimulationTopology(PoseContext.Pose, BoneContainer);
+	ActivateSimulationTopology(PoseContext, BoneContainer);
+}
+
+void FLKAnimNode_AnimVerlet::BuildSimulationTopology(FCSPose<FCompactPose>& Pose, const FBoneContainer& BoneContainer)
+{
+#if LK_ENABLE_STAT
+	SCOPE_CYCLE_COUNTER(STAT_AnimVerlet_BuildSimulationTopology);
+#endif
+
 	verify(SimulateBones.Num() == 0);
 
 	USkeleton* Skeleton = BoneContainer.GetSkeletonAsset();
@@ -316,7 +569,7 @@ void FLKAnimNode_AnimVerlet::InitializeSimulateBones(FComponentSpacePoseContext&
 	{
 		const int32 FoundBoneIndex = ReferenceSkeleton.FindBoneIndex(CurBoneSetting.RootBone.BoneName);
 		if (FoundBoneIndex != INDEX_NONE)
-			MakeSimulateBones(PoseContext, BoneContainer, ReferenceSkeleton, FoundBoneIndex, INDEX_NONE, INDEX_NONE, CurBoneSetting, false, INDEX_NONE);
+			MakeSimulateBones(Pose, BoneContainer, ReferenceSkeleton, FoundBoneIndex, INDEX_NONE, INDEX_NONE, CurBoneSetting, false, INDEX_NONE);
 	}
 
 	/// Create constraints
@@ -809,73 +1062,151 @@ void FLKAnimNode_AnimVerlet::InitializeSimulateBones(FComponentSpacePoseContext&
 		}
 	}
 
-	InitializeCustomDistanceConstraints(PoseContext, BoneContainer);
+	InitializeCustomDistanceConstraints(Pose, BoneContainer);
+
+	/// LocalCollision(Contact) constraints
+	InitializeLocalCollisionConstraints(BoneContainer);
+}
+
+void FLKAnimNode_AnimVerlet::ActivateSimulationTopology(FComponentSpacePoseContext& PoseContext, const FBoneContainer& BoneContainer)
+{
+#if LK_ENABLE_STAT
+	SCOPE_CYCLE_COUNTER(STAT_AnimVerlet_ActivateSimulationTopology);
+#endif
 
+	/// The broadphase and chain collisions point to the arrays of this node, so they are never built on another node
 	if (bUseBroadphase)
 	{
 		InitializeBroadphase();
 	}
 
-	/// SelfCollision(Contact) constraints
-	if (bUseSelfCollision)
+	InitializeChainCollisionConstraints(PoseContext, BoneContainer);
+
+	BuildSleepIslands();
+}
+
+void FLKAnimNode_AnimVerlet::LaunchAsyncTopologyBuild(const FBoneContainer& BoneContainer)
+{
+	CancelAsyncTopologyBuild();
+
+	/// The builder only gets the inputs of the build(settings, bone settings and LOD chain resolution), not the runtime state of this node.
+	/// Collision assets are converted here, so the task never touches them. The skeleton behind the required bones stays alive
+	/// because this node always waits for the task before it is destroyed or rebuilt(CancelAsyncTopologyBuild).
+	AsyncTopologyBuilder = MakeShared<FLKAnimNode_AnimVerlet, ESPMode::ThreadSafe>();
+	AsyncTopologyBuilder->SyncFromOtherAnimVerletNode(*this);
+	AsyncTopologyBuilder->VerletBones = VerletBones;
+	AsyncTopologyBuilder->LODChainResolutionStride = LODChainResolutionStride;
+
+	FLKAnimVerletCollisionShapeList CollisionShapes;
+	GatherCollisionShapes(OUT CollisionShapes, BoneContainer);
+	AsyncTopologyBuilder->SphereCollisionShapes = MoveTemp(CollisionShapes.SphereCollisionShapes);
+	AsyncTopologyBuilder->CapsuleCollisionShapes = MoveTemp(CollisionShapes.CapsuleCollisionShapes);
+	AsyncTopologyBuilder->BoxCollisionShapes = MoveTemp(CollisionShapes.BoxCollisionShapes);
+	AsyncTopologyBuilder->PlaneCollisionShapes = MoveTemp(CollisionShapes.PlaneCollisionShapes);
+	AsyncTopologyBuilder->CollisionDataAsset = nullptr;
+	AsyncTopologyBuilder->CollisionPhysicsAsset = nullptr;
+	AsyncTopologyBuilder->TopologyAsset = nullptr;
+
+	AsyncTopologyTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Builder = AsyncTopologyBuilder, BuildBoneContainer = BoneContainer]()
 	{
-		FLKAnimVerletCollisionConstraintInput CollisionConstraintInput;
-		{
-			CollisionConstraintInput.Bones = &SimulateBones;
-			CollisionConstraintInput.bUseBroadphase = bUseBroadphase;
-			CollisionConstraintInput.bUseCapsuleCollisionForChain = bUseCapsuleCollisionForChain;
-			CollisionConstraintInput.bSingleChain = bSingleChain;
-			CollisionConstraintInput.SimulateBonePairIndicators = &SimulateBonePairIndicators;
-			CollisionConstraintInput.SimulateBoneTriangleIndicators = &SimulateBoneTriangleIndicators;
-			CollisionConstraintInput.BroadphaseContainer = &BroadphaseContainer;
-			CollisionConstraintInput.bUseXPBDSolver = bUseXPBDSolver;
-			CollisionConstraintInput.Compliance = Compliance;
-		}
-		const FLKAnimVerletConstraint_Self SelfCollisionConstraint(bUseTriangleSelfCollision, SelfCollisionAdditionalThickness, CollisionConstraintInput);
-		SelfCollisionConstraints.Emplace(SelfCollisionConstraint);
+		/// Compact poses allocate from the mem stack of the running thread
+		FMemMark Mark(FMemStack::Get());
+		FCSPose<FCompactPose> ReferencePose;
+		ReferencePose.InitPose(&BuildBoneContainer);
+		Builder->BuildSimulationTopology(ReferencePose, BuildBoneContainer);
+	});
+}
+
+bool FLKAnimNode_AnimVerlet::ActivateAsyncTopology(FComponentSpacePoseContext& PoseContext, const FBoneContainer& BoneContainer)
+{
+	verify(SimulateBones.Num() == 0 && AsyncTopologyBuilder.IsValid());
+
+	FLKAnimVerletSimulationTopology BuiltTopology;
+	AsyncTopologyBuilder->SwapSimulationTopology(BuiltTopology);
+	Swap(SimulatingCollisionShapes, AsyncTopologyBuilder->SimulatingCollisionShapes);
+
+	/// The LOD changed the chain resolution while building
+	const bool bStaleTopology = (AsyncTopologyBuilder->LODChainResolutionStride != LODChainResolutionStride);
+	CancelAsyncTopologyBuild();
+	if (bStaleTopology)
+	{
+		ClearSimulationTopology();
+		return false;
 	}
 
-	/// WorldCollision(Contact) constraints
-	if (WorldCollisionProfile != NAME_None)
+	SwapSimulationTopology(BuiltTopology);
+	InitializeSimulationBoneReferences(BoneContainer);
+
+	/// The required bones changed with the LOD while building
+	if (HasAllSimulationBoneReferences() == false)
 	{
-		if (PoseContext.AnimInstanceProxy != nullptr)
-		{
-			USkeletalMeshComponent* SkeletalMeshComponent = PoseContext.AnimInstanceProxy->GetSkelMeshComponent();
-			if (SkeletalMeshComponent != nullptr)
-			{
-				FLKAnimVerletCollisionConstraintInput CollisionConstraintInput;
-				{
-					CollisionConstraintInput.Bones = &SimulateBones;
-					CollisionConstraintInput.bUseBroadphase = bUseBroadphase;
-					CollisionConstraintInput.bUseCapsuleCollisionForChain = bUseCapsuleCollisionForChain;
-					CollisionConstraintInput.bSingleChain = bSingleChain;
-					CollisionConstraintInput.SimulateBonePairIndicators = &SimulateBonePairIndicators;
-					CollisionConstraintInput.SimulateBoneTriangleIndicators = &SimulateBoneTriangleIndicators;
-					CollisionConstraintInput.BroadphaseContainer = &BroadphaseContainer;
-					CollisionConstraintInput.bUseXPBDSolver = bUseXPBDSolver;
-					CollisionConstraintInput.Compliance = Compliance;
-					CollisionConstraintInput.FrictionCoefficient = FrictionCoefficient;
+		ClearSimulationTopology();
+		return false;
+	}
 
-					CollisionConstraintInput.ExcludeBones.Init(false, SimulateBones.Num());
-					for (int32 i = 0; i < WorldCollisionExcludeBones.Num(); ++i)
-					{
-						WorldCollisionExcludeBones[i].Initialize(BoneContainer);
-						const int32 FoundIndex = SimulateBones.IndexOfByKey(FLKAnimVerletBoneKey(WorldCollisionExcludeBones[i]));
-						if (FoundIndex != INDEX_NONE)
-							CollisionConstraintInput.ExcludeBones[FoundIndex] = true;
-					}
-				}
+	ActivateSimulationTopology(PoseContext, BoneContainer);
+	return true;
+}
 
-				const UWorld* World = SkeletalMeshComponent->GetWorld();
+void FLKAnimNode_AnimVerlet::CancelAsyncTopologyBuild()
+{
+	/// A running task reads the required bones(and the skeleton behind them), so it must not outlive this node or the current setup
+	if (AsyncTopologyTask.IsValid() && AsyncTopologyTask.IsCompleted() == false)
+	{
+#if LK_ENABLE_STAT
+		SCOPE_CYCLE_COUNTER(STAT_AnimVerlet_WaitAsyncTopologyBuild);
+#endif
+		AsyncTopologyTask.Wait();
+	}
 
-				const FLKAnimVerletConstraint_World WorldCollisionConstraint(World, SkeletalMeshComponent, WorldCollisionProfile, CollisionConstraintInput);
-				WorldCollisionConstraints.Emplace(WorldCollisionConstraint);
-			}
-		}
+	AsyncTopologyBuilder.Reset();
+	AsyncTopologyTask = UE::Tasks::FTask();
+}
+
+bool FLKAnimNode_AnimVerlet::LoadTopologyAsset(FComponentSpacePoseContext& PoseContext, const FBoneContainer& BoneContainer)
+{
+#if LK_ENABLE_STAT
+	SCOPE_CYCLE_COUNTER(STAT_AnimVerlet_LoadTopologyAsset);
+#endif
+
+	verify(SimulateBones.Num() == 0 && TopologyAsset != nullptr);
+
+	/// Baked at the full chain resolution with the required bones of LOD 0. Any other LOD builds at runtime for the rest of this initialization.
+	bool bLoaded = false;
+	if (LODChainResolutionStride == 1)
+	{
+		FLKAnimVerletSimulationTopology LoadedTopology;
+		TopologyAsset->CopyTopology(OUT LoadedTopology);
+		SwapSimulationTopology(LoadedTopology);
+		InitializeSimulationBoneReferences(BoneContainer);
+		bLoaded = HasAllSimulationBoneReferences();
+	}
+
+	if (bLoaded == false)
+	{
+		ClearSimulationTopology();
+		bTopologyAssetUpToDate = false;
+		return false;
 	}
 
-	/// LocalCollision(Contact) constraints
 	InitializeLocalCollisionConstraints(BoneContainer);
+	ActivateSimulationTopology(PoseContext, BoneContainer);
+	return true;
+}
+
+bool FLKAnimNode_AnimVerlet::HasAllSimulationBoneReferences() const
+{
+	for (const FLKAnimVerletBone& CurBone : SimulateBones)
+	{
+		if (CurBone.bFakeBone == false && CurBone.BoneReference.CachedCompactPoseIndex == INDEX_NONE)
+			return false;
+	}
+	for (const FLKAnimVerletExcludedBone& CurBone : ExcludedBones)
+	{
+		if (CurBone.BoneReference.CachedCompactPoseIndex == INDEX_NONE)
+			return false;
+	}
+	return true;
 }
 
 void FLKAnimNode_AnimVerlet::RebuildSimulationForLOD(FComponentSpacePoseContext& PoseContext, const FBoneContainer& BoneContainer)
@@ -926,11 +1257,47 @@ void FLKAnimNode_AnimVerlet::RebuildSimulationForLOD(FComponentSpacePoseContext&
 		PreservedStateIndexesByBoneName.Emplace(State.BoneName, StateIndex);
 	}
 
-	ClearSimulateBones();
-	InitializeSimulateBones(PoseContext, BoneContainer);
+	/// Bones skipped by a reduced chain resolution may become simulated bones
+	TMap<FName, FVector, TInlineSetAllocator<64>> PreservedExcludedLocations;
+	for (const FLKAnimVerletExcludedBone& Bone : ExcludedBones)
+	{
+		if (Bone.Location.ContainsNaN() == false)
+			PreservedExcludedLocations.Emplace(Bone.BoneReference.BoneName, Bone.Location);
+	}
+
+	/// Park the current topology and swap in the one built when the new LOD was last simulated instead of walking the skeleton again
+	const uint32 NewTopologyKey = MakeLODTopologyKey();
+	bool bRestoredTopology = false;
+	if (bCacheSimulationPerLOD == false)
+	{
+		LODTopologyCache.Reset();
+	}
+	else if (NewTopologyKey != ActiveLODTopologyKey)
+	{
+		SwapSimulationTopology(LODTopologyCache.FindOrAdd(ActiveLODTopologyKey));
+		bRestoredTopology = RestoreCachedLODTopology(NewTopologyKey, BoneContainer);
+	}
 
-	for (FLKAnimVerletBone& Bone : SimulateBones)
+	if (bRestoredTopology == false)
 	{
+		ClearSimulationTopology();
+		InitializeSimulateBones(PoseContext, BoneContainer);
+	}
+	ActiveLODTopologyKey = NewTopologyKey;
+
+	/// A restored topology still holds the state of its last simulated frame. Unmatched bones keep that shape relative to their parent.
+	TArray<FVector, TInlineAllocator<64>> StaleLocations;
+	if (bRestoredTopology)
+	{
+		StaleLocations.Reserve(SimulateBones.Num());
+		for (const FLKAnimVerletBone& Bone : SimulateBones)
+			StaleLocations.Emplace(Bone.Location);
+	}
+
+	TArray<int32, TInlineAllocator<64>> UnmatchedBoneIndexes;
+	for (int32 BoneIndex = 0; BoneIndex < SimulateBones.Num(); ++BoneIndex)
+	{
+		FLKAnimVerletBone& Bone = SimulateBones[BoneIndex];
 		const FName ParentBoneName = (Bone.HasParentBone() && SimulateBones.IsValidIndex(Bone.ParentVerletBoneIndex) ? SimulateBones[Bone.ParentVerletBoneIndex].BoneReference.BoneName : NAME_None);
 		FLKPreservedBoneState* MatchingState = nullptr;
 		for (auto StateIt = PreservedStateIndexesByBoneName.CreateKeyIterator(Bone.BoneReference.BoneName); StateIt; ++StateIt)
@@ -944,7 +1311,10 @@ void FLKAnimNode_AnimVerlet::RebuildSimulationForLOD(FComponentSpacePoseContext&
 			}
 		}
 		if (MatchingState == nullptr)
+		{
+			UnmatchedBoneIndexes.Emplace(BoneIndex);
 			continue;
+		}
 
 		Bone.Location = MatchingState->Location;
 		Bone.PrevLocation = MatchingState->PrevLocation;
@@ -956,60 +1326,216 @@ void FLKAnimNode_AnimVerlet::RebuildSimulationForLOD(FComponentSpacePoseContext&
 		Bone.SleepTriggerElapsedTime = MatchingState->SleepTriggerElapsedTime;
 		MatchingState->bUsed = true;
 	}
-}
-
-void FLKAnimNode_AnimVerlet::InitializeCustomDistanceConstraints(FComponentSpacePoseContext& PoseContext, const FBoneContainer& BoneContainer)
-{
-	if (CustomDistanceConstraints.IsEmpty())
-		return;
-
-	/// Constraint endpoints store raw pointers. Reserving the maximum possible number of anchors keeps those pointers stable while the list is built.
-	CustomDistanceConstraintBones.Reserve(CustomDistanceConstraints.Num() * 2);
 
-	const double Compliance = static_cast<double>(1.0 / InvCompliance);
-	const double SolverStiffness = bUseXPBDSolver ? Compliance : static_cast<double>(Stiffness);
-	for (const FLKAnimVerletCustomDistanceConstraintSetting& CurConstraintSetting : CustomDistanceConstraints)
+	/// A different chain resolution changes the parent of the remaining bones. Match them by bone name only.
+	/// Parents are stored before their children, so a parent is already restored when its child is seeded from it.
+	for (const int32 BoneIndex : UnmatchedBoneIndexes)
 	{
-		FLKAnimVerletBone* BoneA = FindOrAddCustomDistanceConstraintBone(CurConstraintSetting.BoneA, PoseContext, BoneContainer);
-		FLKAnimVerletBone* BoneB = FindOrAddCustomDistanceConstraintBone(CurConstraintSetting.BoneB, PoseContext, BoneContainer);
-		if (BoneA == nullptr || BoneB == nullptr || BoneA == BoneB)
+		FLKAnimVerletBone& Bone = SimulateBones[BoneIndex];
+		FLKPreservedBoneState* MatchingState = nullptr;
+		for (auto StateIt = PreservedStateIndexesByBoneName.CreateKeyIterator(Bone.BoneReference.BoneName); StateIt; ++StateIt)
+		{
+			FLKPreservedBoneState& State = PreservedStates[StateIt.Value()];
+			if (State.bUsed == false && State.bFakeBone == Bone.bFakeBone && State.bSubDividedBone == Bone.bSubDividedBone && State.bTipBone == Bone.bTipBone)
+			{
+				MatchingState = &State;
+				break;
+			}
+		}
+
+		if (MatchingState != nullptr)
+		{
+			Bone.Location = MatchingState->Location;
+			Bone.PrevLocation = MatchingState->PrevLocation;
+			Bone.Rotation = MatchingState->Rotation;
+			Bone.PrevRotation = MatchingState->PrevRotation;
+			Bone.MoveDelta = MatchingState->MoveDelta;
+			Bone.Velocity = MatchingState->Velocity;
+			MatchingState->bUsed = true;
 			continue;
+		}
 
-		const FLKAnimVerletConstraint_Distance NewDistanceConstraint(BoneA, BoneB, bUseXPBDSolver, SolverStiffness, bStretchEachBone, StretchStrength,
-																	 CurConstraintSetting.MinDistance, CurConstraintSetting.MaxDistance);
-		DistanceConstraints.Emplace(NewDistanceConstraint);
+		/// Newly simulated bone. Start from its interpolated location and move with its parent.
+		const bool bHasParent = (Bone.HasParentBone() && SimulateBones.IsValidIndex(Bone.ParentVerletBoneIndex));
+		const FVector ParentMoveDelta = bHasParent ? SimulateBones[Bone.ParentVerletBoneIndex].Location - SimulateBones[Bone.ParentVerletBoneIndex].PrevLocation : FVector::ZeroVector;
+		const FVector* FoundExcludedLocation = Bone.bFakeBone ? nullptr : PreservedExcludedLocations.Find(Bone.BoneReference.BoneName);
+		if (bRestoredTopology)
+		{
+			Bone.MoveDelta = FVector::ZeroVector;
+			Bone.Velocity = FVector::ZeroVector;
+			Bone.bSleep = false;
+			Bone.SleepTriggerElapsedTime = 0.0f;
+		}
+
+		if (FoundExcludedLocation != nullptr)
+		{
+			Bone.Location = *FoundExcludedLocation;
+			Bone.PrevLocation = Bone.Location - ParentMoveDelta;
+		}
+		else if (bRestoredTopology && bHasParent)
+		{
+			Bone.Location = SimulateBones[Bone.ParentVerletBoneIndex].Location + (StaleLocations[BoneIndex] - StaleLocations[Bone.ParentVerletBoneIndex]);
+			Bone.PrevLocation = Bone.Location - ParentMoveDelta;
+		}
 	}
 }
 
-FLKAnimVerletBone* FLKAnimNode_AnimVerlet::FindOrAddCustomDistanceConstraintBone(const FBoneReference& BoneReference, FComponentSpacePoseContext& PoseContext, const FBoneContainer& BoneContainer)
+bool FLKAnimNode_AnimVerlet::RestoreCachedLODTopology(uint32 InTopologyKey, const FBoneContainer& BoneContainer)
 {
-	/// Subdivided particles inherit the real bone reference, so prefer the real skeletal particle when both share the same FBoneReference.
-	int32 SimulateBoneIndex = SimulateBones.IndexOfByPredicate([&BoneReference] (const FLKAnimVerletBone& SimulateBone) {
-		return SimulateBone.bFakeBone == false && SimulateBone.BoneReference == BoneReference;
-	});
-
-	if (SimulateBoneIndex == INDEX_NONE)
-		SimulateBoneIndex = SimulateBones.IndexOfByKey(FLKAnimVerletBoneKey(BoneReference));
-	if (SimulateBoneIndex != INDEX_NONE)
-		return &SimulateBones[SimulateBoneIndex];
+	FLKAnimVerletSimulationTopology* FoundTopology = LODTopologyCache.Find(InTopologyKey);
+	if (FoundTopology == nullptr)
+		return false;
 
-	const int32 ExistingAnchorIndex = CustomDistanceConstraintBones.IndexOfByKey(FLKAnimVerletBoneKey(BoneReference));
-	if (ExistingAnchorIndex != INDEX_NONE)
-		return &CustomDistanceConstraintBones[ExistingAnchorIndex];
+	SwapSimulationTopology(*FoundTopology);
+	LODTopologyCache.Remove(InTopologyKey);
+	ResetTopologyTransientState();
+	InitializeSimulationBoneReferences(BoneContainer);
 
-	FBoneReference InitializedBoneReference = BoneReference;
-	InitializedBoneReference.Initialize(BoneContainer);
-	const FCompactPoseBoneIndex PoseBoneIndex = InitializedBoneReference.GetCompactPoseIndex(BoneContainer);
-	if (PoseBoneIndex == INDEX_NONE)
-		return nullptr;
+	/// The required bones of a LOD stay the same while the mesh does. A missing bone means the parked topology is stale.
+	if (HasAllSimulationBoneReferences() == false)
+		return false;
 
-	FLKAnimVerletBone NewAnchorBone;
-	{
-		NewAnchorBone.BoneReference = InitializedBoneReference;
+	for (FLKAnimVerletSleepIsland& CurIsland : SleepIslands)
+		CurIsland.bSleep = false;
+	ForEachConstraints([](FLKAnimVerletConstraint& CurConstraint) {
+		CurConstraint.ResetSimulation();
+	});
+	return true;
+}
+
+void FLKAnimNode_AnimVerlet::SwapSimulationTopology(IN OUT FLKAnimVerletSimulationTopology& InOutTopology)
+{
+	/// Swapping keeps every array allocation, so the bone pointers held by the constraints stay valid on both sides
+	Swap(SimulateBones, InOutTopology.SimulateBones);
+	Swap(ExcludedBones, InOutTopology.ExcludedBones);
+	Swap(RelevantBoneIndicators, InOutTopology.RelevantBoneIndicators);
+	Swap(SimulateBonePairIndicators, InOutTopology.SimulateBonePairIndicators);
+	Swap(SimulateBoneTriangleIndicators, InOutTopology.SimulateBoneTriangleIndicators);
+	Swap(BroadphaseContainer, InOutTopology.BroadphaseContainer);
+
+	Swap(PinConstraints, InOutTopology.PinConstraints);
+	Swap(DistanceConstraints, InOutTopology.DistanceConstraints);
+	Swap(BendingConstraints, InOutTopology.BendingConstraints);
+	Swap(BendingConstraints_1D, InOutTopology.BendingConstraints_1D);
+	Swap(FlatBendingConstraints, InOutTopology.FlatBendingConstraints);
+	Swap(StraightenConstraints, InOutTopology.StraightenConstraints);
+	Swap(FixedDistanceConstraints, InOutTopology.FixedDistanceConstraints);
+	Swap(BallSocketConstraints, InOutTopology.BallSocketConstraints);
+	Swap(SphereCollisionConstraints, InOutTopology.SphereCollisionConstraints);
+	Swap(CapsuleCollisionConstraints, InOutTopology.CapsuleCollisionConstraints);
+	Swap(BoxCollisionConstraints, InOutTopology.BoxCollisionConstraints);
+	Swap(PlaneCollisionConstraints, InOutTopology.PlaneCollisionConstraints);
+	Swap(WorldCollisionConstraints, InOutTopology.WorldCollisionConstraints);
+	Swap(SelfCollisionConstraints, InOutTopology.SelfCollisionConstraints);
+	Swap(CustomDistanceConstraintBones, InOutTopology.CustomDistanceConstraintBones);
+	Swap(BoneChainIndexes, InOutTopology.BoneChainIndexes);
+	Swap(MaxBoneChainLength, InOutTopology.MaxBoneChainLength);
+	Swap(MaxThickness, InOutTopology.MaxThickness);
+	Swap(WorldCollisionExcludeBoneBits, InOutTopology.WorldCollisionExcludeBoneBits);
+	Swap(SleepIslands, InOutTopology.SleepIslands);
+	Swap(SimulateBoneIslandIndexes, InOutTopology.SimulateBoneIslandIndexes);
+}
+
+uint32 FLKAnimNode_AnimVerlet::MakeLODTopologyKey() const
+{
+	/// Everything ApplyLODFeatureOverrides bakes into the topology
+	uint32 TopologyKey = GetTypeHash(CachedSimulationLOD);
+	TopologyKey = HashCombine(TopologyKey, GetTypeHash(LODChainResolutionStride));
+	TopologyKey = HashCombine(TopologyKey, GetTypeHash(ShouldUseCapsuleCollisionForChain()));
+	return TopologyKey;
+}
+
+void FLKAnimNode_AnimVerlet::ApplyLODFeatureOverrides(int32 LODLevel, OUT bool& bOutChainCollisionShapeChanged, OUT bool& bOutChainResolutionChanged)
+{
+	const FLKAnimVerletLODFeatureSetting* FoundSetting = nullptr;
+	for (const FLKAnimVerletLODFeatureSetting& CurSetting : LODFeatureOverrides)
+	{
+		if (LODLevel >= CurSetting.MinLOD && (FoundSetting == nullptr || CurSetting.MinLOD > FoundSetting->MinLOD))
+			FoundSetting = &CurSetting;
+	}
+
+	const bool bPrevAllowCapsuleCollisionForChain = bLODAllowCapsuleCollisionForChain;
+	const int32 PrevChainResolutionStride = LODChainResolutionStride;
+	LODMaxSolveIteration = FoundSetting != nullptr ? FMath::Max(FoundSetting->MaxSolveIteration, 0) : 0;
+	bLODAllowSelfCollision = (FoundSetting == nullptr || FoundSetting->bDisableSelfCollision == false);
+	bLODAllowWorldCollision = (FoundSetting == nullptr || FoundSetting->bDisableWorldCollision == false);
+	bLODAllowBendingConstraints = (FoundSetting == nullptr || FoundSetting->bDisableBendingConstraints == false);
+	bLODAllowConeAngleConstraints = (FoundSetting == nullptr || FoundSetting->bDisableConeAngleConstraints == false);
+	bLODAllowCapsuleCollisionForChain = (FoundSetting == nullptr || FoundSetting->bUseSphereCollisionForChain == false);
+	LODChainResolutionStride = FoundSetting != nullptr ? FMath::Max(FoundSetting->ChainResolutionStride, 1) : 1;
+	bLODUseProceduralSway = (FoundSetting != nullptr && FoundSetting->bUseProceduralSway);
+
+	/// Only the chain collision shape and the chain resolution are baked into the simulation. Every other feature is skipped at solve time.
+	bOutChainCollisionShapeChanged = bUseCapsuleCollisionForChain && bPrevAllowCapsuleCollisionForChain != bLODAllowCapsuleCollisionForChain;
+	bOutChainResolutionChanged = PrevChainResolutionStride != LODChainResolutionStride;
+}
+
+void FLKAnimNode_AnimVerlet::RebuildChainCollisionConstraints(FComponentSpacePoseContext& PoseContext, const FBoneContainer& BoneContainer)
+{
+	/// Topology and bone-to-bone constraints are unaffected by the chain collision shape. Rebuild only what references it.
+	SelfCollisionConstraints.Reset();
+	WorldCollisionConstraints.Reset();
+	if (bUseBroadphase)
+	{
+		BroadphaseContainer.Destroy();
+		InitializeBroadphase();
+	}
+	InitializeChainCollisionConstraints(PoseContext, BoneContainer);
+	bHasSleepingResultCache = false;
+}
+
+void FLKAnimNode_AnimVerlet::InitializeCustomDistanceConstraints(FCSPose<FCompactPose>& Pose, const FBoneContainer& BoneContainer)
+{
+	if (CustomDistanceConstraints.IsEmpty())
+		return;
+
+	/// Constraint endpoints store raw pointers. Reserving the maximum possible number of anchors keeps those pointers stable while the list is built.
+	CustomDistanceConstraintBones.Reserve(CustomDistanceConstraints.Num() * 2);
+
+	const double Compliance = static_cast<double>(1.0 / InvCompliance);
+	const double SolverStiffness = bUseXPBDSolver ? Compliance : static_cast<double>(Stiffness);
+	for (const FLKAnimVerletCustomDistanceConstraintSetting& CurConstraintSetting : CustomDistanceConstraints)
+	{
+		FLKAnimVerletBone* BoneA = FindOrAddCustomDistanceConstraintBone(CurConstraintSetting.BoneA, Pose, BoneContainer);
+		FLKAnimVerletBone* BoneB = FindOrAddCustomDistanceConstraintBone(CurConstraintSetting.BoneB, Pose, BoneContainer);
+		if (BoneA == nullptr || BoneB == nullptr || BoneA == BoneB)
+			continue;
+
+		const FLKAnimVerletConstraint_Distance NewDistanceConstraint(BoneA, BoneB, bUseXPBDSolver, SolverStiffness, bStretchEachBone, StretchStrength,
+																	 CurConstraintSetting.MinDistance, CurConstraintSetting.MaxDistance);
+		DistanceConstraints.Emplace(NewDistanceConstraint);
+	}
+}
+
+FLKAnimVerletBone* FLKAnimNode_AnimVerlet::FindOrAddCustomDistanceConstraintBone(const FBoneReference& BoneReference, FCSPose<FCompactPose>& Pose, const FBoneContainer& BoneContainer)
+{
+	/// Subdivided particles inherit the real bone reference, so prefer the real skeletal particle when both share the same FBoneReference.
+	int32 SimulateBoneIndex = SimulateBones.IndexOfByPredicate([&BoneReference] (const FLKAnimVerletBone& SimulateBone) {
+		return SimulateBone.bFakeBone == false && SimulateBone.BoneReference == BoneReference;
+	});
+
+	if (SimulateBoneIndex == INDEX_NONE)
+		SimulateBoneIndex = SimulateBones.IndexOfByKey(FLKAnimVerletBoneKey(BoneReference));
+	if (SimulateBoneIndex != INDEX_NONE)
+		return &SimulateBones[SimulateBoneIndex];
+
+	const int32 ExistingAnchorIndex = CustomDistanceConstraintBones.IndexOfByKey(FLKAnimVerletBoneKey(BoneReference));
+	if (ExistingAnchorIndex != INDEX_NONE)
+		return &CustomDistanceConstraintBones[ExistingAnchorIndex];
+
+	FBoneReference InitializedBoneReference = BoneReference;
+	InitializedBoneReference.Initialize(BoneContainer);
+	const FCompactPoseBoneIndex PoseBoneIndex = InitializedBoneReference.GetCompactPoseIndex(BoneContainer);
+	if (PoseBoneIndex == INDEX_NONE)
+		return nullptr;
+
+	FLKAnimVerletBone NewAnchorBone;
+	{
+		NewAnchorBone.BoneReference = InitializedBoneReference;
 		NewAnchorBone.bPinned = true;
 		NewAnchorBone.InvMass = 0.0f;
 		NewAnchorBone.bUseXPBDSolver = bUseXPBDSolver;
-		NewAnchorBone.InitializeTransform(PoseContext.Pose.GetComponentSpaceTransform(PoseBoneIndex));
+		NewAnchorBone.InitializeTransform(Pose.GetComponentSpaceTransform(PoseBoneIndex));
 	}
 	return &CustomDistanceConstraintBones.Emplace_GetRef(MoveTemp(NewAnchorBone));
 }
@@ -1018,7 +1544,7 @@ void FLKAnimNode_AnimVerlet::InitializeBroadphase()
 {
 	verify(bUseBroadphase);
 
-	if (bUseCapsuleCollisionForChain)
+	if (ShouldUseCapsuleCollisionForChain())
 	{
 		if (IsSingleChain())
 		{
@@ -1035,16 +1561,102 @@ void FLKAnimNode_AnimVerlet::InitializeBroadphase()
 	}
 }
 
-void FLKAnimNode_AnimVerlet::InitializeLocalCollisionConstraints(const FBoneContainer& BoneContainer)
+void FLKAnimNode_AnimVerlet::InitializeChainCollisionConstraints(FComponentSpacePoseContext& PoseContext, const FBoneContainer& BoneContainer)
+{
+	const double Compliance = static_cast<double>(1.0 / InvCompliance);
+
+	/// SelfCollision(Contact) constraints
+	if (bUseSelfCollision)
+	{
+		FLKAnimVerletCollisionConstraintInput CollisionConstraintInput;
+		{
+			CollisionConstraintInput.Bones = &SimulateBones;
+			CollisionConstraintInput.bUseBroadphase = bUseBroadphase;
+			CollisionConstraintInput.bUseCapsuleCollisionForChain = ShouldUseCapsuleCollisionForChain();
+			CollisionConstraintInput.bSingleChain = bSingleChain;
+			CollisionConstraintInput.SimulateBonePairIndicators = &SimulateBonePairIndicators;
+			CollisionConstraintInput.SimulateBoneTriangleIndicators = &SimulateBoneTriangleIndicators;
+			CollisionConstraintInput.BroadphaseContainer = &BroadphaseContainer;
+			CollisionConstraintInput.bUseXPBDSolver = bUseXPBDSolver;
+			CollisionConstraintInput.Compliance = Compliance;
+		}
+		const FLKAnimVerletConstraint_Self SelfCollisionConstraint(bUseTriangleSelfCollision, SelfCollisionAdditionalThickness, CollisionConstraintInput);
+		SelfCollisionConstraints.Emplace(SelfCollisionConstraint);
+	}
+
+	/// WorldCollision(Contact) constraints
+	WorldCollisionExcludeBoneBits.Init(false, SimulateBones.Num());
+	for (int32 i = 0; i < WorldCollisionExcludeBones.Num(); ++i)
+	{
+		WorldCollisionExcludeBones[i].Initialize(BoneContainer);
+		const int32 FoundIndex = SimulateBones.IndexOfByKey(FLKAnimVerletBoneKey(WorldCollisionExcludeBones[i]));
+		if (FoundIndex != INDEX_NONE)
+			WorldCollisionExcludeBoneBits[FoundIndex] = true;
+	}
+	WorldGroundPlane = FLKAnimVerletWorldContactPlane();
+
+	/// The ground plane proxy is solved as a local plane collision instead
+	if (WorldCollisionProfile != NAME_None && bUseWorldGroundPlane == false)
+	{
+		if (PoseContext.AnimInstanceProxy != nullptr)
+		{
+			USkeletalMeshComponent* SkeletalMeshComponent = PoseContext.AnimInstanceProxy->GetSkelMeshComponent();
+			if (SkeletalMeshComponent != nullptr)
+			{
+				FLKAnimVerletCollisionConstraintInput CollisionConstraintInput;
+				{
+					CollisionConstraintInput.Bones = &SimulateBones;
+					CollisionConstraintInput.bUseBroadphase = bUseBroadphase;
+					CollisionConstraintInput.bUseCapsuleCollisionForChain = ShouldUseCapsuleCollisionForChain();
+					CollisionConstraintInput.bSingleChain = bSingleChain;
+					CollisionConstraintInput.SimulateBonePairIndicators = &SimulateBonePairIndicators;
+					CollisionConstraintInput.SimulateBoneTriangleIndicators = &SimulateBoneTriangleIndicators;
+					CollisionConstraintInput.BroadphaseContainer = &BroadphaseContainer;
+					CollisionConstraintInput.bUseXPBDSolver = bUseXPBDSolver;
+					CollisionConstraintInput.Compliance = Compliance;
+					CollisionConstraintInput.FrictionCoefficient = FrictionCoefficient;
+
+					CollisionConstraintInput.ExcludeBones = WorldCollisionExcludeBoneBits;
+				}
+
+				FLKAnimVerletWorldCollisionConstraintInput WorldCollisionConstraintInput;
+				{
+					WorldCollisionConstraintInput.bUseAsyncQuery = bUseAsyncWorldCollision;
+					WorldCollisionConstraintInput.bUseGeometryCache = bUseWorldGeometryCache;
+					WorldCollisionConstraintInput.GeometryCacheMargin = WorldGeometryCacheMargin;
+					WorldCollisionConstraintInput.bUseContactCache = bUseWorldCollisionContactCache;
+					WorldCollisionConstraintInput.ContactCacheDistance = WorldCollisionContactCacheDistance;
+					WorldCollisionConstraintInput.ContactCacheMotionThreshold = WorldCollisionContactCacheMotionThreshold;
+					WorldCollisionConstraintInput.bUseChainEarlyOut = bUseWorldCollisionEarlyOut;
+					WorldCollisionConstraintInput.ChainEarlyOutMargin = WorldCollisionEarlyOutMargin;
+					WorldCollisionConstraintInput.bSkipStationaryBones = bSkipWorldCollisionForStationaryBones;
+					WorldCollisionConstraintInput.StationaryThreshold = WorldCollisionStationaryThreshold;
+				}
+
+				const UWorld* World = SkeletalMeshComponent->GetWorld();
+
+				const FLKAnimVerletConstraint_World WorldCollisionConstraint(World, SkeletalMeshComponent, WorldCollisionProfile, CollisionConstraintInput, WorldCollisionConstraintInput);
+				WorldCollisionConstraints.Emplace(WorldCollisionConstraint);
+			}
+		}
+	}
+}
+
+void FLKAnimNode_AnimVerlet::GatherCollisionShapes(OUT FLKAnimVerletCollisionShapeList& OutShapeList, const FBoneContainer& BoneContainer) const
 {
-	SimulatingCollisionShapes.SphereCollisionShapes = SphereCollisionShapes;
-	SimulatingCollisionShapes.CapsuleCollisionShapes = CapsuleCollisionShapes;
-	SimulatingCollisionShapes.BoxCollisionShapes = BoxCollisionShapes;
-	SimulatingCollisionShapes.PlaneCollisionShapes = PlaneCollisionShapes;
+	OutShapeList.SphereCollisionShapes = SphereCollisionShapes;
+	OutShapeList.CapsuleCollisionShapes = CapsuleCollisionShapes;
+	OutShapeList.BoxCollisionShapes = BoxCollisionShapes;
+	OutShapeList.PlaneCollisionShapes = PlaneCollisionShapes;
 	if (CollisionDataAsset != nullptr)
-		CollisionDataAsset->ConvertToShape(OUT SimulatingCollisionShapes);
+		CollisionDataAsset->ConvertToShape(OUT OutShapeList);
 	if (CollisionPhysicsAsset != nullptr)
-		ConvertPhysicsAssetToShape(OUT SimulatingCollisionShapes, *CollisionPhysicsAsset, &BoneContainer);
+		ConvertPhysicsAssetToShape(OUT OutShapeList, *CollisionPhysicsAsset, &BoneContainer);
+}
+
+void FLKAnimNode_AnimVerlet::InitializeLocalCollisionConstraints(const FBoneContainer& BoneContainer)
+{
+	GatherCollisionShapes(OUT SimulatingCollisionShapes, BoneContainer);
 
 	for (FLKAnimVerletCollisionSphere& CurShape : SimulatingCollisionShapes.SphereCollisionShapes)
 	{
@@ -1079,7 +1691,7 @@ void FLKAnimNode_AnimVerlet::InitializeAttachedShape(FLKAnimVerletCollisionShape
 	}
 }
 
-bool FLKAnimNode_AnimVerlet::MakeSimulateBones(FComponentSpacePoseContext& PoseContext, const FBoneContainer& BoneContainer, const FReferenceSkeleton& ReferenceSkeleton, int32 BoneIndex, 
+bool FLKAnimNode_AnimVerlet::MakeSimulateBones(FCSPose<FCompactPose>& Pose, const FBoneContainer& BoneContainer, const FReferenceSkeleton& ReferenceSkeleton, int32 BoneIndex, 
 											   int32 ParentSimulateBoneIndex, int32 RootSimulateBoneIndex, const FLKAnimVerletBoneSetting& BoneSetting, bool bParentExcluded, int32 ParentExcludedBoneIndex)
 {
 	verify(BoneIndex >= 0 && BoneIndex < ReferenceSkeleton.GetNum());
@@ -1090,7 +1702,8 @@ bool FLKAnimNode_AnimVerlet::MakeSimulateBones(FComponentSpacePoseContext& PoseC
 	int32 CurSimulateBoneIndex = ParentSimulateBoneIndex;
 	int32 CurExcludedBoneIndex = ParentExcludedBoneIndex;
 	bool bNewlyExcluded = false;
-	const bool bExcludedBone = (BoneSetting.ExcludeBones.Find(CurBoneRef) != INDEX_NONE);
+	const bool bChainResolutionSkipped = (ParentSimulateBoneIndex != INDEX_NONE && IsChainResolutionSkippedBone(BoneContainer, ReferenceSkeleton, BoneIndex, BoneSetting));
+	const bool bExcludedBone = bChainResolutionSkipped || (BoneSetting.ExcludeBones.Find(CurBoneRef) != INDEX_NONE);
 	const FLKAnimVerletBoneUnitSetting* FoundBoneUnitSettingNullable = BoneSetting.BoneUnitSettingOverride.FindByKey(CurBoneRef);
 	if (bExcludedBone == false)
 	{
@@ -1101,7 +1714,7 @@ bool FLKAnimNode_AnimVerlet::MakeSimulateBones(FComponentSpacePoseContext& PoseC
 		if (NewSimulateBone.BoneReference.CachedCompactPoseIndex == INDEX_NONE)
 			return false;
 
-		FTransform ReferenceBonePoseT = PoseContext.Pose.GetComponentSpaceTransform(NewSimulateBone.BoneReference.CachedCompactPoseIndex);
+		FTransform ReferenceBonePoseT = Pose.GetComponentSpaceTransform(NewSimulateBone.BoneReference.CachedCompactPoseIndex);
 		NewSimulateBone.bFakeBone = BoneSetting.bFakeBone;
 		NewSimulateBone.bUseXPBDSolver = bUseXPBDSolver;
 		NewSimulateBone.bConstrainConeAngleFromParent = bConstrainConeAngleFromParent;
@@ -1187,6 +1800,8 @@ bool FLKAnimNode_AnimVerlet::MakeSimulateBones(FComponentSpacePoseContext& PoseC
 
 		MaxThickness = FMath::Max(MaxThickness, NewSimulateBone.Thickness);
 		CurSimulateBoneIndex = SimulateBones.Emplace(NewSimulateBone);
+		if (bParentExcluded && ParentExcludedBoneIndex != INDEX_NONE)
+			LinkChainResolutionSkippedBones(ParentExcludedBoneIndex, CurSimulateBoneIndex);
 		if (BoneSetting.bFakeBone == false)
 			RelevantBoneIndicators.Emplace(CurSimulateBoneIndex, false, bParentExcluded ? ParentExcludedBoneIndex : ParentSimulateBoneIndex, bParentExcluded);
 		if (NewSimulateBone.ParentVerletBoneIndex != INDEX_NONE)
@@ -1214,7 +1829,7 @@ bool FLKAnimNode_AnimVerlet::MakeSimulateBones(FComponentSpacePoseContext& PoseC
 		NewExcludedBone.BoneReference.Initialize(BoneContainer);
 		if (NewExcludedBone.BoneReference.CachedCompactPoseIndex != INDEX_NONE)
 		{
-			const FTransform ReferenceBonePoseT = PoseContext.Pose.GetComponentSpaceTransform(NewExcludedBone.BoneReference.CachedCompactPoseIndex);
+			const FTransform ReferenceBonePoseT = Pose.GetComponentSpaceTransform(NewExcludedBone.BoneReference.CachedCompactPoseIndex);
 			NewExcludedBone.PrepareSimulation(ReferenceBonePoseT);
 
 			if (bParentExcluded == false && ParentSimulateBoneIndex != INDEX_NONE)
@@ -1222,6 +1837,7 @@ bool FLKAnimNode_AnimVerlet::MakeSimulateBones(FComponentSpacePoseContext& PoseC
 			else if (bParentExcluded && ParentExcludedBoneIndex != INDEX_NONE)
 				NewExcludedBone.LengthToParent = (ExcludedBones[ParentExcludedBoneIndex].PoseLocation - ReferenceBonePoseT.GetLocation()).Size();
 			NewExcludedBone.bStraightenExcludedBonesByParent = BoneSetting.bStraightenExcludedBonesByParent;
+			NewExcludedBone.bChainResolutionSkipped = bChainResolutionSkipped;
 
 			CurExcludedBoneIndex = ExcludedBones.Emplace(NewExcludedBone);
 			if (BoneSetting.bFakeBone == false)
@@ -1229,7 +1845,7 @@ bool FLKAnimNode_AnimVerlet::MakeSimulateBones(FComponentSpacePoseContext& PoseC
 			bNewlyExcluded = true;
 		}
 	}
-	const bool bTipBone = (WalkChildsAndMakeSimulateBones(PoseContext, BoneContainer, ReferenceSkeleton, BoneIndex, CurSimulateBoneIndex, RootSimulateBoneIndex, BoneSetting, bNewlyExcluded, CurExcludedBoneIndex) == false);
+	const bool bTipBone = (WalkChildsAndMakeSimulateBones(Pose, BoneContainer, ReferenceSkeleton, BoneIndex, CurSimulateBoneIndex, RootSimulateBoneIndex, BoneSetting, bNewlyExcluded, CurExcludedBoneIndex) == false);
 
 	if (bTipBone)
 	{
@@ -1327,7 +1943,7 @@ bool FLKAnimNode_AnimVerlet::MakeSimulateBones(FComponentSpacePoseContext& PoseC
 	return true;
 }
 
-bool FLKAnimNode_AnimVerlet::WalkChildsAndMakeSimulateBones(FComponentSpacePoseContext& PoseContext, const FBoneContainer& BoneContainer, const FReferenceSkeleton& ReferenceSkeleton, int32 BoneIndex, 
+bool FLKAnimNode_AnimVerlet::WalkChildsAndMakeSimulateBones(FCSPose<FCompactPose>& Pose, const FBoneContainer& BoneContainer, const FReferenceSkeleton& ReferenceSkeleton, int32 BoneIndex, 
 															int32 ParentSimulateBoneIndex, int32 RootSimulateBoneIndex, const FLKAnimVerletBoneSetting& BoneSetting, bool bParentExcluded, int32 ParentExcludedBoneIndex)
 {
 	bool bWalked = false;
@@ -1336,13 +1952,69 @@ bool FLKAnimNode_AnimVerlet::WalkChildsAndMakeSimulateBones(FComponentSpacePoseC
 	{
 		if (BoneIndex == ReferenceSkeleton.GetParentIndex(ChildIndex))
 		{
-			MakeSimulateBones(PoseContext, BoneContainer, ReferenceSkeleton, ChildIndex, ParentSimulateBoneIndex, RootSimulateBoneIndex, BoneSetting, bParentExcluded, ParentExcludedBoneIndex);
+			MakeSimulateBones(Pose, BoneContainer, ReferenceSkeleton, ChildIndex, ParentSimulateBoneIndex, RootSimulateBoneIndex, BoneSetting, bParentExcluded, ParentExcludedBoneIndex);
 			bWalked = true;
 		}
 	}
 	return bWalked;
 }
 
+bool FLKAnimNode_AnimVerlet::IsChainResolutionSkippedBone(const FBoneContainer& BoneContainer, const FReferenceSkeleton& ReferenceSkeleton, int32 BoneIndex, const FLKAnimVerletBoneSetting& BoneSetting) const
+{
+	/// Fake bone chains have no relevant bone indicators for excluded bones
+	if (LODChainResolutionStride <= 1 || BoneSetting.bFakeBone)
+		return false;
+
+	const FLKAnimVerletBoneUnitSetting* FoundBoneUnitSettingNullable = BoneSetting.BoneUnitSettingOverride.FindByKey(FBoneReference(ReferenceSkeleton.GetBoneName(BoneIndex)));
+	if (FoundBoneUnitSettingNullable != nullptr && FoundBoneUnitSettingNullable->bLockBone)
+		return false;
+
+	/// Tips and branches keep the shape of the chain
+	int32 NumValidChildren = 0;
+	for (int32 ChildIndex = BoneIndex + 1; ChildIndex < ReferenceSkeleton.GetNum(); ++ChildIndex)
+	{
+		if (ReferenceSkeleton.GetParentIndex(ChildIndex) == BoneIndex && BoneContainer.GetPoseBoneIndexForBoneName(ReferenceSkeleton.GetBoneName(ChildIndex)) != INDEX_NONE)
+			++NumValidChildren;
+	}
+	if (NumValidChildren != 1)
+		return false;
+
+	int32 DepthFromRoot = 0;
+	for (int32 CurBoneIndex = BoneIndex; CurBoneIndex != INDEX_NONE && ReferenceSkeleton.GetBoneName(CurBoneIndex) != BoneSetting.RootBone.BoneName; CurBoneIndex = ReferenceSkeleton.GetParentIndex(CurBoneIndex))
+		++DepthFromRoot;
+	return (DepthFromRoot % LODChainResolutionStride) != 0;
+}
+
+void FLKAnimNode_AnimVerlet::LinkChainResolutionSkippedBones(int32 LastSkippedBoneIndex, int32 ChildSimulateBoneIndex)
+{
+	TArray<int32, TInlineAllocator<8>> SkippedBoneIndexes;
+	for (int32 CurIndex = LastSkippedBoneIndex; CurIndex != INDEX_NONE && ExcludedBones[CurIndex].bChainResolutionSkipped; CurIndex = ExcludedBones[CurIndex].ParentExcludedBoneIndex)
+		SkippedBoneIndexes.Emplace(CurIndex);
+	if (SkippedBoneIndexes.Num() == 0)
+		return;
+
+	/// A run that starts below a user excluded bone has no simulated parent to interpolate from. Keep straightening it.
+	const FLKAnimVerletExcludedBone& FirstSkippedBone = ExcludedBones[SkippedBoneIndexes.Last()];
+	if (FirstSkippedBone.HasExcludedParentBone() || FirstSkippedBone.HasVerletParentBone() == false)
+		return;
+
+	/// Interpolation alpha is the pose arc length from the simulated parent
+	float TotalLength = (SimulateBones[ChildSimulateBoneIndex].PoseLocation - ExcludedBones[LastSkippedBoneIndex].PoseLocation).Size();
+	for (const int32 CurIndex : SkippedBoneIndexes)
+		TotalLength += ExcludedBones[CurIndex].LengthToParent;
+	if (TotalLength <= KINDA_SMALL_NUMBER)
+		return;
+
+	float CurLength = 0.0f;
+	for (int32 i = SkippedBoneIndexes.Num() - 1; i >= 0; --i)
+	{
+		FLKAnimVerletExcludedBone& CurSkippedBone = ExcludedBones[SkippedBoneIndexes[i]];
+		CurLength += CurSkippedBone.LengthToParent;
+		CurSkippedBone.InterpolationChildVerletBoneIndex = ChildSimulateBoneIndex;
+		CurSkippedBone.InterpolationAlpha = CurLength / TotalLength;
+	}
+}
+
 void FLKAnimNode_AnimVerlet::MakeFakeBoneTransform(OUT FTransform& OutTransform, int32 ParentSimulateBoneIndex, float InFakeBoneLength) const
 {
 	verify(SimulateBones.IsValidIndex(ParentSimulateBoneIndex));
@@ -1354,6 +2026,44 @@ void FLKAnimNode_AnimVerlet::MakeFakeBoneTransform(OUT FTransform& OutTransform,
 
 void FLKAnimNode_AnimVerlet::UpdateDeltaTime(float InDeltaTime, float InTimeDilation)
 {
+	/// Frozen by the budget scheduler or skipped offscreen: hold the result and drop the elapsed time
+	if (ShouldHoldSimulation() && bPause == false)
+	{
+		INC_DWORD_STAT(STAT_AnimVerlet_SkippedUpdateFrames);
+		SkippedUpdateDeltaTime = 0.0f;
+		SkippedUpdateFrames = 0;
+		FixedStepAccumulator = 0.0f;
+		NumPendingSimulationSteps = 0;
+		return;
+	}
+
+	/// Significance LOD and budget time slicing: only every Nth frame simulates and receives the delta time of the skipped frames
+	int32 NumUpdateFrames = 1;
+	if (UpdateFrameInterval > 1 && bPause == false)
+	{
+		SkippedUpdateDeltaTime += FMath::Max(InDeltaTime, 0.0f);
+		++SkippedUpdateFrames;
+		if (SkippedUpdateFrames < UpdateFrameInterval)
+		{
+			INC_DWORD_STAT(STAT_AnimVerlet_SkippedUpdateFrames);
+			NumPendingSimulationSteps = 0;
+			return;
+		}
+
+		InDeltaTime = SkippedUpdateDeltaTime;
+		NumUpdateFrames = SkippedUpdateFrames;
+		SkippedUpdateDeltaTime = 0.0f;
+		SkippedUpdateFrames = 0;
+	}
+	else
+	{
+		/// Time left over from a longer interval(e.g. becoming visible again) is simulated now. Fixed steps are still bounded by MaxSubStep.
+		if (SkippedUpdateFrames > 0 && bPause == false)
+			InDeltaTime = FMath::Max(InDeltaTime, 0.0f) + SkippedUpdateDeltaTime;
+		SkippedUpdateDeltaTime = 0.0f;
+		SkippedUpdateFrames = 0;
+	}
+
 	const float PositiveFrameDeltaTime = FMath::Max(InDeltaTime, 0.0f);
 	const float ClampedFrameDeltaTime = FMath::Clamp(InDeltaTime, MinDeltaTime, MaxDeltaTime);
 	const bool bUseFixedDeltaTime = FMath::IsNearlyZero(FixedDeltaTime, KINDA_SMALL_NUMBER) == false;
@@ -1374,7 +2084,8 @@ void FLKAnimNode_AnimVerlet::UpdateDeltaTime(float InDeltaTime, float InTimeDila
 		return;
 	}
 
-	DeltaTime = FMath::Clamp(FixedDeltaTime * InTimeDilation, MinDeltaTime, MaxDeltaTime);
+	/// A reduced update rate takes proportionally longer fixed steps instead of more of them
+	DeltaTime = FMath::Clamp(FixedDeltaTime * InTimeDilation * NumUpdateFrames, MinDeltaTime, MaxDeltaTime);
 	if (bApplyDeltaTimeCorrection == false)
 	{
 		FixedStepAccumulator = 0.0f;
@@ -1382,8 +2093,8 @@ void FLKAnimNode_AnimVerlet::UpdateDeltaTime(float InDeltaTime, float InTimeDila
 		return;
 	}
 
-	const int32 ClampedMaxSubStep = FMath::Max(MaxSubStep, 1);
-	const float TargetFrameRate = FMath::Max(DeltaTimeCorrectionTargetFrameRate, 1.0f);
+	const int32 ClampedMaxSubStep = FMath::Max(EffectiveMaxSubStep, 1);
+	const float TargetFrameRate = FMath::Max(DeltaTimeCorrectionTargetFrameRate, 1.0f) / NumUpdateFrames;
 	FixedStepAccumulator = FMath::Min(FixedStepAccumulator + PositiveFrameDeltaTime * TargetFrameRate, static_cast<float>(ClampedMaxSubStep));
 	NumPendingSimulationSteps = FMath::Min(FMath::FloorToInt(FixedStepAccumulator + UE_SMALL_NUMBER), ClampedMaxSubStep);
 }
@@ -1394,6 +2105,12 @@ void FLKAnimNode_AnimVerlet::PrepareSimulation(FComponentSpacePoseContext& PoseC
 	SCOPE_CYCLE_COUNTER(STAT_AnimVerlet_PrepareSimulation);
 #endif
 
+	PrepareSimulateBonePoses(PoseContext, BoneContainer, ComponentTransform);
+	PrepareLocalCollisionConstraints(PoseContext, BoneContainer, ComponentTransform);
+}
+
+void FLKAnimNode_AnimVerlet::PrepareSimulateBonePoses(FComponentSpacePoseContext& PoseContext, const FBoneContainer& BoneContainer, const FTransform& ComponentTransform)
+{
 	for (int32 SimulateBoneIndex = 0; SimulateBoneIndex < SimulateBones.Num(); ++SimulateBoneIndex)
 	{
 		FLKAnimVerletBone& CurSimulateBone = SimulateBones[SimulateBoneIndex];
@@ -1460,8 +2177,6 @@ void FLKAnimNode_AnimVerlet::PrepareSimulation(FComponentSpacePoseContext& PoseC
 		CurAnchorBone.Rotation = CurAnchorBone.PoseRotation;
 		CurAnchorBone.PrevRotation = CurAnchorBone.PoseRotation;
 	}
-
-	PrepareLocalCollisionConstraints(PoseContext, BoneContainer, ComponentTransform);
 }
 
 FQuat FLKAnimNode_AnimVerlet::CalculateGravityAlignmentRotation(const FTransform& ComponentTransform) const
@@ -1496,7 +2211,7 @@ void FLKAnimNode_AnimVerlet::PrepareLocalCollisionConstraints(FComponentSpacePos
 	{
 		CollisionConstraintInput.Bones = &SimulateBones;
 		CollisionConstraintInput.bUseBroadphase = bUseBroadphase;
-		CollisionConstraintInput.bUseCapsuleCollisionForChain = bUseCapsuleCollisionForChain;
+		CollisionConstraintInput.bUseCapsuleCollisionForChain = ShouldUseCapsuleCollisionForChain();
 		CollisionConstraintInput.bSingleChain = bSingleChain;
 		CollisionConstraintInput.SimulateBonePairIndicators = &SimulateBonePairIndicators;
 		CollisionConstraintInput.SimulateBoneTriangleIndicators = &SimulateBoneTriangleIndicators;
@@ -1774,6 +2489,47 @@ void FLKAnimNode_AnimVerlet::PrepareLocalCollisionConstraints(FComponentSpacePos
 			}
 		}
 	}
+
+	///----------------------------------------------------------------------------------------------------------------------------
+	/// World geometry cache
+	///----------------------------------------------------------------------------------------------------------------------------
+	for (FLKAnimVerletConstraint_World& CurWorldConstraint : WorldCollisionConstraints)
+	{
+		if (CurWorldConstraint.bUseGeometryCache == false || bLODAllowWorldCollision == false)
+			continue;
+
+		CollisionConstraintInput.ExcludeBones = CurWorldConstraint.ExcludeBones;
+		for (const FLKAnimVerletWorldCachedShape& CurSphere : CurWorldConstraint.CachedSpheres)
+		{
+			const FVector BoneLocation = ComponentTransform.InverseTransformPosition(CurSphere.Location);
+			SphereCollisionConstraints.Emplace(BoneLocation, CurSphere.HalfExtents.X, CollisionConstraintInput);
+		}
+		for (const FLKAnimVerletWorldCachedShape& CurCapsule : CurWorldConstraint.CachedCapsules)
+		{
+			const FVector BoneLocation = ComponentTransform.InverseTransformPosition(CurCapsule.Location);
+			const FQuat BoneRotation = ComponentTransform.InverseTransformRotation(CurCapsule.Rotation);
+			CapsuleCollisionConstraints.Emplace(BoneLocation, BoneRotation, CurCapsule.HalfExtents.X, CurCapsule.HalfExtents.Z, CollisionConstraintInput);
+		}
+		for (const FLKAnimVerletWorldCachedShape& CurBox : CurWorldConstraint.CachedBoxes)
+		{
+			const FVector BoneLocation = ComponentTransform.InverseTransformPosition(CurBox.Location);
+			const FQuat BoneRotation = ComponentTransform.InverseTransformRotation(CurBox.Rotation);
+			BoxCollisionConstraints.Emplace(BoneLocation, BoneRotation, CurBox.HalfExtents, CollisionConstraintInput);
+		}
+		CurWorldConstraint.PrepareGeometryCache(ComponentTransform);
+	}
+
+	///----------------------------------------------------------------------------------------------------------------------------
+	/// World ground plane proxy
+	///----------------------------------------------------------------------------------------------------------------------------
+	if (bUseWorldGroundPlane && WorldGroundPlane.bValid && bLODAllowWorldCollision)
+	{
+		CollisionConstraintInput.ExcludeBones = WorldCollisionExcludeBoneBits;
+
+		const FVector PlaneLocation = ComponentTransform.InverseTransformPosition(WorldGroundPlane.Location);
+		const FVector PlaneNormal = ComponentTransform.InverseTransformVectorNoScale(WorldGroundPlane.Normal).GetSafeNormal();
+		PlaneCollisionConstraints.Emplace(PlaneLocation, PlaneNormal, FRotationMatrix::MakeFromZ(PlaneNormal).ToQuat(), FVector2D::ZeroVector, CollisionConstraintInput);
+	}
 }
 
 void FLKAnimNode_AnimVerlet::ConvertPhysicsAssetToShape(OUT FLKAnimVerletCollisionShapeList& OutShapeList, const UPhysicsAsset& InPhysicsAsset, const FBoneContainer* BoneContainerNullable) const
@@ -1828,6 +2584,15 @@ void FLKAnimNode_AnimVerlet::SimulateVerlet(const UWorld* World, float InDeltaTi
 	verify(World != nullptr);
 
 	const bool bComponentInertiaApplied = PreUpdateBones(World, InDeltaTime, ComponentTransform, PrevComponentTransform);
+	INC_DWORD_STAT_BY(STAT_AnimVerlet_SleepingIslands, NumSleepingIslands);
+
+	/// Every island is asleep and no wake event happened in PreUpdateBones. Nothing moves, so the rest of the step is skipped
+	if (AreAllIslandsAsleep())
+	{
+		INC_DWORD_STAT(STAT_AnimVerlet_SkippedSleepingSteps);
+		UpdateSleepingBoneStat(SimulateBones.Num());
+		return;
+	}
 
 	if (bUseBroadphase)
 		UpdateBroadphase(World, InDeltaTime, ComponentTransform);
@@ -1837,49 +2602,48 @@ void FLKAnimNode_AnimVerlet::SimulateVerlet(const UWorld* World, float InDeltaTi
 
 	if (bComponentInertiaApplied)
 		ApplyComponentInertiaTangentialDamping(InDeltaTime);
-	
-	if (bUseSleep)
-		UpdateSleep(InDeltaTime);
 
+	/// Sleep and PostUpdate run in the same pass
 	PostUpdateBones(InDeltaTime);
 }
 
-bool FLKAnimNode_AnimVerlet::PreUpdateBones(const UWorld* World, float InDeltaTime, const FTransform& ComponentTransform, const FTransform& PrevComponentTransform)
+void FLKAnimNode_AnimVerlet::PrepareFrameUpdateParam(const FTransform& ComponentTransform, const FTransform& PrevComponentTransform, int32 NumSteps)
 {
 #if LK_ENABLE_STAT
-	SCOPE_CYCLE_COUNTER(STAT_AnimVerlet_PreUpdateBones);
+	SCOPE_CYCLE_COUNTER(STAT_AnimVerlet_PrepareFrameUpdateParam);
 #endif
 
 	extern ENGINE_API float GAverageFPS;
 	const bool bUseCorrectedFixedStep = FMath::IsNearlyZero(FixedDeltaTime, KINDA_SMALL_NUMBER) == false && bApplyDeltaTimeCorrection;
 	const float CorrectionFrameRate = bUseCorrectedFixedStep ? FMath::Max(DeltaTimeCorrectionTargetFrameRate, 1.0f) : FMath::Clamp(GAverageFPS, LKG_MINFPS, LKG_MAXFPS);
-	const bool bUseWindComponentInWorld = (bAdjustWindComponent && World->Scene != nullptr);
-	FLKAnimVerletUpdateParam VerletUpdateParam;
+
+	/// Substeps interpolate the component transform uniformly, so every substep sees the same delta as the first one
+	FTransform FirstStepComponentTransform;
+	FirstStepComponentTransform.Blend(PrevComponentTransform, ComponentTransform, 1.0f / static_cast<float>(FMath::Max(NumSteps, 1)));
+
+	FLKAnimVerletUpdateParam& VerletUpdateParam = FrameUpdateParam.UpdateParam;
 	{
-		/// Clamp Move Intertia
+		/// Clamp Move Intertia(as a scale for each substep`s move delta, which still varies with the interpolated rotation)
 		{
-			const FVector PrevComponentLocation = PrevComponentTransform.GetLocation();
-			VerletUpdateParam.ComponentMoveDiff = ComponentTransform.InverseTransformPosition(PrevComponentLocation);
-			FVector MoveDiffDir = FVector::ZeroVector;
-			float MoveDiffDist = 0.0f;
-			VerletUpdateParam.ComponentMoveDiff.ToDirectionAndLength(OUT MoveDiffDir, OUT MoveDiffDist);
+			const FVector StepMoveDiff = FirstStepComponentTransform.InverseTransformPosition(PrevComponentTransform.GetLocation());
+			const float MoveDiffDist = StepMoveDiff.Size();
 
 			const bool bIgnoreMoveInertia = bIgnoreSuddenMoveInertia && MoveDiffDist > FMath::Max(MoveInertiaIgnoreThreshold, 0.0f);
 			if (bIgnoreMoveInertia)
 			{
-				VerletUpdateParam.ComponentMoveDiff = FVector::ZeroVector;
+				FrameUpdateParam.MoveInertiaFactor = 0.0f;
 			}
 			else
 			{
-				MoveDiffDist = bClampMoveInertia ? FMath::Clamp(MoveDiffDist, 0.0f, MoveInertiaClampMaxDistance) : MoveDiffDist;
-				VerletUpdateParam.ComponentMoveDiff = MoveDiffDir * MoveDiffDist * MoveInertiaScale;
+				const float ClampedMoveDiffDist = bClampMoveInertia ? FMath::Clamp(MoveDiffDist, 0.0f, MoveInertiaClampMaxDistance) : MoveDiffDist;
+				FrameUpdateParam.MoveInertiaFactor = (MoveDiffDist > KINDA_SMALL_NUMBER ? ClampedMoveDiffDist / MoveDiffDist : 1.0f) * MoveInertiaScale;
 			}
 		}
 
 		/// Clamp Rotation Intertia
 		{
 			const FQuat PrevComponentRotation = PrevComponentTransform.GetRotation();
-			VerletUpdateParam.ComponentRotDiff = ComponentTransform.InverseTransformRotation(PrevComponentRotation);
+			VerletUpdateParam.ComponentRotDiff = FirstStepComponentTransform.InverseTransformRotation(PrevComponentRotation);
 			FVector RotDiffAxis = FVector::ZeroVector;
 			float RotDiffAngle = 0.0f;
 			VerletUpdateParam.ComponentRotDiff.ToAxisAndAngle(OUT RotDiffAxis, OUT RotDiffAngle);
@@ -1899,20 +2663,30 @@ bool FLKAnimNode_AnimVerlet::PreUpdateBones(const UWorld* World, float InDeltaTi
 			}
 		}
 
+		/// Inertial frame: the rotation delta is kept as a rotation vector and only its change is applied in PreUpdateBones
+		FrameUpdateParam.ComponentRotVector = VerletUpdateParam.ComponentRotDiff.ToRotationVector();
+		VerletUpdateParam.bApplyInertialDisplacement = bSimulateInInertialFrame;
+		if (bSimulateInInertialFrame)
+			VerletUpdateParam.ComponentRotDiff = FQuat::Identity;
+
 		VerletUpdateParam.bUseSquaredDeltaTime = bUseSquaredDeltaTime;
 		VerletUpdateParam.StretchForce = StretchForce;
 		VerletUpdateParam.bAlignStretchForceToGravity = bAlignStretchForceToGravity;
 		VerletUpdateParam.SideStraightenForce = SideStraightenForce;
 		VerletUpdateParam.ShapeMemoryForce = ShapeMemoryForce;
 		VerletUpdateParam.bAlignShapeMemoryForceToGravity = bAlignShapeMemoryForceToGravity;
+		const FVector PrevGravity = VerletUpdateParam.Gravity;
+		const FVector PrevExternalForce = VerletUpdateParam.ExternalForce;
 		VerletUpdateParam.Gravity = (bGravityInWorldSpace == false || Gravity.IsNearlyZero(KINDA_SMALL_NUMBER)) ? Gravity : ComponentTransform.InverseTransformVector(Gravity);
 		VerletUpdateParam.ExternalForce = (bExternalForceInWorldSpace == false || ExternalForce.IsNearlyZero(KINDA_SMALL_NUMBER)) ? ExternalForce : ComponentTransform.InverseTransformVector(ExternalForce);
+		FrameUpdateParam.bForceChanged = (VerletUpdateParam.Gravity.Equals(PrevGravity, KINDA_SMALL_NUMBER) == false || VerletUpdateParam.ExternalForce.Equals(PrevExternalForce, KINDA_SMALL_NUMBER) == false);
 
 		const bool bUseRandomWind = (RandomWindDirection.IsNearlyZero(KINDA_SMALL_NUMBER) == false);
 		VerletUpdateParam.RandomWind.RandomForceDirection = (bRandomWindDirectionInWorldSpace == false && bUseRandomWind) ? RandomWindDirection : ComponentTransform.InverseTransformVector(RandomWindDirection);
 		VerletUpdateParam.RandomWind.RandomForceSizeMin = RandomWindSizeMin;
 		VerletUpdateParam.RandomWind.RandomForceSizeMax = RandomWindSizeMax;
 		VerletUpdateParam.RandomWind.bRandomForceDirectionInWorldSpace = bRandomWindDirectionInWorldSpace;
+		VerletUpdateParam.AdditionalRandomWinds.Reset();
 		for (const FLKAnimVerletRandomForceSetting& CurWind : AdditionalRandomWinds)
 		{
 			FLKAnimVerletRandomForceSetting& NewWind = VerletUpdateParam.AdditionalRandomWinds.Emplace_GetRef();
@@ -1921,33 +2695,101 @@ bool FLKAnimNode_AnimVerlet::PreUpdateBones(const UWorld* World, float InDeltaTi
 			NewWind.RandomForceSizeMax = CurWind.RandomForceSizeMax;
 			NewWind.bRandomForceDirectionInWorldSpace = CurWind.bRandomForceDirectionInWorldSpace;
 		}
+		VerletUpdateParam.RandomWindNoiseFrequency = RandomWindNoiseFrequency;
+		VerletUpdateParam.RandomWindSeed = static_cast<uint32>(RandomWindSeed);
 		VerletUpdateParam.Damping = bApplyDampingCorrection ? FMath::Clamp(FMath::Pow(Damping, (DampingCorrectionTargetFrameRate / CorrectionFrameRate)), 0.0f, 1.0f) : Damping;
 	}
-	const bool bComponentFrameMoved = VerletUpdateParam.ComponentMoveDiff.IsNearlyZero(KINDA_SMALL_NUMBER) == false || VerletUpdateParam.ComponentRotDiff.Equals(FQuat::Identity, KINDA_SMALL_NUMBER) == false;
+
+	FrameUpdateParam.WindVelocitiesInCS.Reset();
+	if (bAdjustWindComponent)
+	{
+		for (const FVector& CurWindVelocity : CachedWindVelocities)
+			FrameUpdateParam.WindVelocitiesInCS.Emplace(ComponentTransform.InverseTransformVector(CurWindVelocity));
+	}
+
+	FrameUpdateParam.bHasContinuousForce = (VerletUpdateParam.RandomWind.RandomForceDirection.IsNearlyZero(KINDA_SMALL_NUMBER) == false && VerletUpdateParam.RandomWind.RandomForceSizeMax > 0.0f);
+	for (const FLKAnimVerletRandomForceSetting& CurWind : VerletUpdateParam.AdditionalRandomWinds)
+		FrameUpdateParam.bHasContinuousForce |= (CurWind.RandomForceDirection.IsNearlyZero(KINDA_SMALL_NUMBER) == false && CurWind.RandomForceSizeMax > 0.0f);
+	for (const FVector& CurWindVelocity : FrameUpdateParam.WindVelocitiesInCS)
+		FrameUpdateParam.bHasContinuousForce |= (CurWindVelocity.IsNearlyZero(KINDA_SMALL_NUMBER) == false);
+
+	///FrameUpdateParam.AnimationPoseDeltaInertia = bApplyAnimationPoseInertiaCorrection ? (AnimationPoseDeltaInertia * AnimationPoseDeltaInertiaScale * AnimationPoseInertiaTargetFrameRate / CorrectionFrameRate) : AnimationPoseDeltaInertia * AnimationPoseDeltaInertiaScale;
+	FrameUpdateParam.AnimationPoseDeltaInertia = AnimationPoseDeltaInertia * AnimationPoseDeltaInertiaScale;
+	FrameUpdateParam.AnimationPoseInertia = bApplyAnimationPoseInertiaCorrection ? (AnimationPoseInertia * AnimationPoseInertiaTargetFrameRate / CorrectionFrameRate) : AnimationPoseInertia;
+}
+
+bool FLKAnimNode_AnimVerlet::PreUpdateBones(const UWorld* World, float InDeltaTime, const FTransform& ComponentTransform, const FTransform& PrevComponentTransform)
+{
+#if LK_ENABLE_STAT
+	SCOPE_CYCLE_COUNTER(STAT_AnimVerlet_PreUpdateBones);
+#endif
+
+	/// Everything except the interpolated component move delta and the wind noise offset is prepared once per frame in PrepareFrameUpdateParam
+	FLKAnimVerletUpdateParam& VerletUpdateParam = FrameUpdateParam.UpdateParam;
+	const FVector StepMoveDiff = ComponentTransform.InverseTransformPosition(PrevComponentTransform.GetLocation()) * FrameUpdateParam.MoveInertiaFactor;
+	bool bComponentFrameMoved = false;
+	if (bSimulateInInertialFrame)
+	{
+		/// Only the change of the component delta(component acceleration) displaces the bones, so constant component motion costs nothing per bone
+		/// The first step after a reset, warmup or a mode switch has no previous delta. Seed it so an already moving component gets no kick.
+		if (bHasPrevInertialDiff == false)
+		{
+			PrevInertialMoveDiff = StepMoveDiff;
+			PrevInertialRotVector = FrameUpdateParam.ComponentRotVector;
+			bHasPrevInertialDiff = true;
+		}
+		VerletUpdateParam.ComponentMoveDiff = FVector::ZeroVector;
+		VerletUpdateParam.InertialLinearDisplacement = StepMoveDiff - PrevInertialMoveDiff;
+		VerletUpdateParam.InertialAngularDisplacement = FrameUpdateParam.ComponentRotVector - PrevInertialRotVector;
+		PrevInertialMoveDiff = StepMoveDiff;
+		PrevInertialRotVector = FrameUpdateParam.ComponentRotVector;
+		bComponentFrameMoved = VerletUpdateParam.InertialLinearDisplacement.IsNearlyZero(KINDA_SMALL_NUMBER) == false || VerletUpdateParam.InertialAngularDisplacement.IsNearlyZero(KINDA_SMALL_NUMBER) == false;
+	}
+	else
+	{
+		bHasPrevInertialDiff = false;
+		VerletUpdateParam.ComponentMoveDiff = StepMoveDiff;
+		bComponentFrameMoved = VerletUpdateParam.ComponentMoveDiff.IsNearlyZero(KINDA_SMALL_NUMBER) == false || VerletUpdateParam.ComponentRotDiff.Equals(FQuat::Identity, KINDA_SMALL_NUMBER) == false;
+	}
+	VerletUpdateParam.RandomWindNoiseOffset = FVector(RandomWindNoiseTime * RandomWindNoiseSpeed);
+	RandomWindNoiseTime += InDeltaTime;
+
+	INC_DWORD_STAT(STAT_AnimVerlet_BonePasses);
+	const bool bUseWindComponentInWorld = (FrameUpdateParam.WindVelocitiesInCS.Num() > 0);
+	const float WakeUpThresholdSQ = WakeUpDeltaThreshold * WakeUpDeltaThreshold;
+
+	if (NumSleepingIslands > 0)
+	{
+		UpdateSleepIslandsWakeUp(bComponentFrameMoved, WakeUpThresholdSQ);
+		if (AreAllIslandsAsleep())
+			return false;
+	}
 
 	/// Simulate each bones	
 	for (int32 i = 0; i < SimulateBones.Num(); ++i)
 	{
+		if (NumSleepingIslands > 0 && IsBoneIndexInSleepingIsland(i))
+			continue;
+
 		FLKAnimVerletBone& CurVerletBone = SimulateBones[i];
-		/// A moving component is an external kinematic input. Keeping a bone asleep here would
-		/// discard the rebased displacement in UpdateSleep and make slow component motion vanish.
-		if (bUseSleep && bComponentFrameMoved)
-			CurVerletBone.WakeUp();
+		/// A sleeping bone only wakes when the component frame displaces it by more than WakeUpDeltaThreshold.
+		/// Below that it rides along with the component frame, so slow component drift does not keep waking it.
+		bool bApplyComponentFrameMotion = true;
+		if (bUseSleep && CurVerletBone.IsSleep())
+		{
+			if (bComponentFrameMoved && VerletUpdateParam.MakeComponentFrameDisplacement(CurVerletBone.Location).SizeSquared() >= WakeUpThresholdSQ)
+				CurVerletBone.WakeUp();
+			else
+				bApplyComponentFrameMotion = false;
+		}
 
-		CurVerletBone.Update(InDeltaTime, VerletUpdateParam);
+		CurVerletBone.Update(InDeltaTime, VerletUpdateParam, bApplyComponentFrameMotion);
 
-		/// UWindDirectionalSourceComponent
+		/// UWindDirectionalSourceComponent(From UE4 AnimDynamics)
 		if (bUseWindComponentInWorld)
 		{
-			/// From UE4 AnimDynamics
-			float WindMinGust = 0.0f;
-			float WindMaxGust = 0.0f;
-
-			FVector WindDirection = FVector::ZeroVector;
-			float WindSpeed = 0.0f;
-			World->Scene->GetWindParameters_GameThread(ComponentTransform.TransformPosition(CurVerletBone.PoseLocation), WindDirection, WindSpeed, WindMinGust, WindMaxGust);
-			WindDirection = ComponentTransform.Inverse().TransformVector(WindDirection);
-			const FVector WindVelocity = WindDirection * WindSpeed * FMath::FRandRange(0.0f, 2.0f);
+			const float WindGust = 2.0f * LKAnimVerletUtil::ValueNoise3D(CurVerletBone.PoseLocation * VerletUpdateParam.RandomWindNoiseFrequency + VerletUpdateParam.RandomWindNoiseOffset, ~VerletUpdateParam.RandomWindSeed);
+			const FVector WindVelocity = SampleCachedWindVelocity(FrameUpdateParam.WindVelocitiesInCS, CurVerletBone.PoseLocation) * WindGust;
 			CurVerletBone.Location += WindVelocity * (InDeltaTime * CurVerletBone.InvMass);
 		}
 
@@ -1955,11 +2797,8 @@ bool FLKAnimNode_AnimVerlet::PreUpdateBones(const UWorld* World, float InDeltaTi
 		if (bIgnoreAnimationPose == false && CurVerletBone.HasParentBone())
 		{
 			FLKAnimVerletBone& ParentVerletBone = SimulateBones[CurVerletBone.ParentVerletBoneIndex];
-			///const float AnimPoseDeltaInertiaScaled = bApplyAnimationPoseInertiaCorrection ? (AnimationPoseDeltaInertia * AnimationPoseDeltaInertiaScale * AnimationPoseInertiaTargetFrameRate / CorrectionFrameRate) : AnimationPoseDeltaInertia * AnimationPoseDeltaInertiaScale;
-			const float AnimPoseDeltaInertiaScaled = AnimationPoseDeltaInertia * AnimationPoseDeltaInertiaScale;
-			const float TargetAnimationPoseInertia = bApplyAnimationPoseInertiaCorrection ? (AnimationPoseInertia * AnimationPoseInertiaTargetFrameRate / CorrectionFrameRate) : AnimationPoseInertia;
 			CurVerletBone.AdjustPoseTransform(InDeltaTime, ParentVerletBone.Location, ParentVerletBone.PoseLocation, ParentVerletBone.GravityAlignedPoseLocation,
-											 bAlignAnimationPoseToGravity, TargetAnimationPoseInertia, AnimPoseDeltaInertiaScaled,
+											 bAlignAnimationPoseToGravity, FrameUpdateParam.AnimationPoseInertia, FrameUpdateParam.AnimationPoseDeltaInertia,
 											 bClampAnimationPoseDeltaInertia, AnimationPoseDeltaInertiaClampMax);
 		}
 	}
@@ -1967,27 +2806,270 @@ bool FLKAnimNode_AnimVerlet::PreUpdateBones(const UWorld* World, float InDeltaTi
 	return bComponentFrameMoved;
 }
 
-void FLKAnimNode_AnimVerlet::UpdateBroadphase(const UWorld* World, float InDeltaTime, const FTransform& ComponentTransform)
+void FLKAnimNode_AnimVerlet::UpdateSignificance_GameThread(const USkeletalMeshComponent* SkeletalMeshComponent)
 {
-#if LK_ENABLE_STAT
-	SCOPE_CYCLE_COUNTER(STAT_AnimVerlet_UpdateBroadphase);
-#endif
+	if (bUseSignificanceLOD == false || SignificanceOverride >= 0.0f || SkeletalMeshComponent == nullptr)
+		return;
 
-	BroadphaseContainer.Update();
+	MeasuredSignificance = CalculateScreenSizeSignificance_GameThread(SkeletalMeshComponent);
 }
 
-void FLKAnimNode_AnimVerlet::SolveConstraints(float InDeltaTime)
+float FLKAnimNode_AnimVerlet::CalculateScreenSizeSignificance_GameThread(const USkeletalMeshComponent* SkeletalMeshComponent) const
 {
-#if LK_ENABLE_STAT
-	SCOPE_CYCLE_COUNTER(STAT_AnimVerlet_SolveConstraints);
-#endif
+	verify(SkeletalMeshComponent != nullptr);
 
-	/// Solve Constraints
-	const float SubStepDeltaTime = FMath::Max(bUseXPBDSolver ? InDeltaTime / SolveIteration : InDeltaTime, KINDA_SMALL_NUMBER);
-	for (int32 Iteration = 0; Iteration < SolveIteration; ++Iteration)
-	{
-		const bool bInitialUpdate = (Iteration == 0);
-		const bool bFinalizeUpdate = (Iteration == SolveIteration - 1);
+	/// No view(server, first frame). Keep full detail
+	const UWorld* World = SkeletalMeshComponent->GetWorld();
+	if (World == nullptr || World->ViewLocationsRenderedLastFrame.Num() == 0)
+		return 1.0f;
+
+	/// Screen size approximation: bounds radius over the distance to the closest view
+	const FBoxSphereBounds& Bounds = SkeletalMeshComponent->Bounds;
+	float MaxScreenSize = 0.0f;
+	for (const FVector& CurViewLocation : World->ViewLocationsRenderedLastFrame)
+	{
+		const float ViewDistance = FMath::Max(static_cast<float>(FVector::Dist(CurViewLocation, Bounds.Origin)), 1.0f);
+		MaxScreenSize = FMath::Max(MaxScreenSize, static_cast<float>(Bounds.SphereRadius) / ViewDistance);
+	}
+	return FMath::Clamp(MaxScreenSize / FMath::Max(SignificanceFullScreenSize, KINDA_SMALL_NUMBER), 0.0f, 1.0f);
+}
+
+void FLKAnimNode_AnimVerlet::UpdateSignificanceLOD()
+{
+	EffectiveSolveIteration = SolveIteration;
+	EffectiveMaxSubStep = MaxSubStep;
+	UpdateFrameInterval = 1;
+	bSignificanceAllowSelfCollision = true;
+	CurrentSignificance = 1.0f;
+	if (bUseSignificanceLOD == false)
+		return;
+
+	CurrentSignificance = FMath::Clamp(SignificanceOverride >= 0.0f ? SignificanceOverride : MeasuredSignificance, 0.0f, 1.0f);
+	EffectiveSolveIteration = FMath::Max(FMath::RoundToInt(FMath::Lerp(1.0f, static_cast<float>(SolveIteration), CurrentSignificance)), 1);
+	EffectiveMaxSubStep = FMath::Max(FMath::RoundToInt(FMath::Lerp(1.0f, static_cast<float>(MaxSubStep), CurrentSignificance)), 1);
+
+	const FLKAnimVerletSignificanceTier* FoundTier = nullptr;
+	for (const FLKAnimVerletSignificanceTier& CurTier : SignificanceTiers)
+	{
+		if (CurrentSignificance >= CurTier.MinSignificance && (FoundTier == nullptr || CurTier.MinSignificance > FoundTier->MinSignificance))
+			FoundTier = &CurTier;
+	}
+	if (FoundTier == nullptr)
+		return;
+
+	EffectiveSolveIteration = FMath::Min(EffectiveSolveIteration, FMath::Max(FoundTier->MaxSolveIteration, 1));
+	EffectiveMaxSubStep = FMath::Min(EffectiveMaxSubStep, FMath::Max(FoundTier->MaxSubStep, 1));
+	UpdateFrameInterval = FMath::Max(FoundTier->UpdateInterval, 1);
+	bSignificanceAllowSelfCollision = FoundTier->bAllowSelfCollision;
+}
+
+void FLKAnimNode_AnimVerlet::UpdateBudget_GameThread(const USkeletalMeshComponent* SkeletalMeshComponent)
+{
+	if (bUseBudgetScheduler == false || SkeletalMeshComponent == nullptr || LKAnimVerletBudgetScheduler::IsEnabled() == false)
+	{
+		BudgetDecision = ELKAnimVerletBudgetDecision::Full;
+		return;
+	}
+
+	/// Priority: gameplay importance x distance(screen size) x visibility. The small floor keeps BudgetPriority ordering for far nodes.
+	const float Significance = (bUseSignificanceLOD && SignificanceOverride >= 0.0f) ? SignificanceOverride : CalculateScreenSizeSignificance_GameThread(SkeletalMeshComponent);
+	const float VisibilityScale = SkeletalMeshComponent->WasRecentlyRendered(0.2f) ? 1.0f : 0.1f;
+	const float Priority = BudgetPriority * FMath::Max(Significance, 0.01f) * VisibilityScale;
+	BudgetDecision = LKAnimVerletBudgetScheduler::Get().UpdateEntry(IN OUT BudgetHandle, Priority);
+}
+
+void FLKAnimNode_AnimVerlet::ApplyBudgetDecision()
+{
+	/// Applied on top of the significance LOD. Each level includes the previous one.
+	if (BudgetDecision >= ELKAnimVerletBudgetDecision::TimeSliced)
+		UpdateFrameInterval = FMath::Max(UpdateFrameInterval, LKAnimVerletBudgetScheduler::TimeSliceInterval);
+	if (BudgetDecision >= ELKAnimVerletBudgetDecision::ReducedIteration)
+	{
+		EffectiveSolveIteration = FMath::Min(EffectiveSolveIteration, LKAnimVerletBudgetScheduler::ReducedSolveIteration);
+		EffectiveMaxSubStep = 1;
+	}
+}
+
+void FLKAnimNode_AnimVerlet::UpdateOffscreen_GameThread(const USkeletalMeshComponent* SkeletalMeshComponent)
+{
+	bOffscreen = (OffscreenMode != ELKAnimVerletOffscreenMode::Simulate && SkeletalMeshComponent != nullptr && SkeletalMeshComponent->WasRecentlyRendered(OffscreenTime) == false);
+}
+
+void FLKAnimNode_AnimVerlet::ApplyOffscreenThrottle()
+{
+	if (OffscreenMode == ELKAnimVerletOffscreenMode::Simulate || bOffscreen == false)
+	{
+		/// Became visible again
+		if (bSimulatedOffscreen)
+		{
+			bSimulatedOffscreen = false;
+			if (bResetWhenBecomeVisible && SimulateBones.Num() > 0)
+			{
+				bPendingDynamicsReset = true;
+				SkippedUpdateDeltaTime = 0.0f;
+				SkippedUpdateFrames = 0;
+			}
+			else
+			{
+				/// Bounded catch-up. The rest of the throttled time is dropped.
+				SkippedUpdateDeltaTime = FMath::Min(SkippedUpdateDeltaTime, FMath::Max(OffscreenMaxCatchUpTime, 0.0f));
+			}
+		}
+		return;
+	}
+
+	bSimulatedOffscreen = true;
+	if (OffscreenMode == ELKAnimVerletOffscreenMode::Throttle)
+		UpdateFrameInterval = FMath::Max(UpdateFrameInterval, FMath::Max(OffscreenUpdateInterval, 1));
+}
+
+bool FLKAnimNode_AnimVerlet::ShouldHoldSimulation() const
+{
+	return (BudgetDecision == ELKAnimVerletBudgetDecision::Frozen || (OffscreenMode == ELKAnimVerletOffscreenMode::Skip && bOffscreen));
+}
+
+void FLKAnimNode_AnimVerlet::UpdateWindComponentCache_GameThread(const USkeletalMeshComponent* SkeletalMeshComponent)
+{
+	CachedWindVelocities.Reset();
+	if (bAdjustWindComponent == false || SkeletalMeshComponent == nullptr)
+		return;
+
+	const UWorld* World = SkeletalMeshComponent->GetWorld();
+	if (World == nullptr || World->Scene == nullptr)
+		return;
+
+#if LK_ENABLE_STAT
+	SCOPE_CYCLE_COUNTER(STAT_AnimVerlet_UpdateWindComponentCache);
+#endif
+
+	/// Spread the sample points along the longest axis of the last simulated pose
+	FBox PoseBox(ForceInit);
+	for (const FLKAnimVerletBone& CurVerletBone : SimulateBones)
+		PoseBox += CurVerletBone.PoseLocation;
+
+	int32 NumSamples = 1;
+	CachedWindSampleStart = FVector::ZeroVector;
+	CachedWindSampleEnd = FVector::ZeroVector;
+	if (PoseBox.IsValid)
+	{
+		const FVector PoseCenter = PoseBox.GetCenter();
+		const FVector PoseExtent = PoseBox.GetExtent();
+		const int32 LongestAxis = (PoseExtent.X >= PoseExtent.Y && PoseExtent.X >= PoseExtent.Z) ? 0 : (PoseExtent.Y >= PoseExtent.Z ? 1 : 2);
+		FVector AxisExtent = FVector::ZeroVector;
+		AxisExtent[LongestAxis] = PoseExtent[LongestAxis];
+
+		CachedWindSampleStart = PoseCenter - AxisExtent;
+		CachedWindSampleEnd = PoseCenter + AxisExtent;
+		NumSamples = FMath::Clamp(WindComponentSampleCount, 1, 8);
+	}
+
+	const FTransform ComponentTransform = SkeletalMeshComponent->GetComponentTransform();
+	for (int32 i = 0; i < NumSamples; ++i)
+	{
+		const float SampleAlpha = (NumSamples > 1) ? static_cast<float>(i) / (NumSamples - 1) : 0.5f;
+		const FVector SampleLocation = ComponentTransform.TransformPosition(FMath::Lerp(CachedWindSampleStart, CachedWindSampleEnd, SampleAlpha));
+
+		float WindMinGust = 0.0f;
+		float WindMaxGust = 0.0f;
+		FVector WindDirection = FVector::ZeroVector;
+		float WindSpeed = 0.0f;
+		World->Scene->GetWindParameters_GameThread(SampleLocation, WindDirection, WindSpeed, WindMinGust, WindMaxGust);
+		CachedWindVelocities.Emplace(WindDirection * WindSpeed * WindComponentScale);
+	}
+}
+
+FVector FLKAnimNode_AnimVerlet::SampleCachedWindVelocity(const TArray<FVector, TInlineAllocator<8>>& InWindVelocities, const FVector& InLocation) const
+{
+	verify(InWindVelocities.Num() > 0);
+	if (InWindVelocities.Num() == 1)
+		return InWindVelocities[0];
+
+	const FVector SampleAxis = CachedWindSampleEnd - CachedWindSampleStart;
+	const float SampleAxisSizeSquared = SampleAxis.SizeSquared();
+	const float SampleAlpha = (SampleAxisSizeSquared > KINDA_SMALL_NUMBER) ? FMath::Clamp(FVector::DotProduct(InLocation - CachedWindSampleStart, SampleAxis) / SampleAxisSizeSquared, 0.0f, 1.0f) : 0.5f;
+	const float SamplePosition = SampleAlpha * (InWindVelocities.Num() - 1);
+	const int32 SampleIndex = FMath::Min(FMath::FloorToInt(SamplePosition), InWindVelocities.Num() - 2);
+	return FMath::Lerp(InWindVelocities[SampleIndex], InWindVelocities[SampleIndex + 1], SamplePosition - SampleIndex);
+}
+
+void FLKAnimNode_AnimVerlet::UpdateBroadphase(const UWorld* World, float InDeltaTime, const FTransform& ComponentTransform)
+{
+#if LK_ENABLE_STAT
+	SCOPE_CYCLE_COUNTER(STAT_AnimVerlet_UpdateBroadphase);
+#endif
+
+	INC_DWORD_STAT(STAT_AnimVerlet_BonePasses);
+	BroadphaseContainer.Update();
+}
+
+void FLKAnimNode_AnimVerlet::UpdateWorldGroundPlane(const UWorld* World, const USkeletalMeshComponent* SkeletalMeshComponent)
+{
+	if (bUseWorldGroundPlane == false || WorldCollisionProfile == NAME_None || bLODAllowWorldCollision == false)
+		return;
+
+#if LK_ENABLE_STAT
+	SCOPE_CYCLE_COUNTER(STAT_AnimVerlet_UpdateWorldGroundPlane);
+#endif
+	verify(World != nullptr);
+	verify(SkeletalMeshComponent != nullptr);
+
+	FCollisionQueryParams CollisionQueryParams(SCENE_QUERY_STAT(LKAnimVerlet));
+	CollisionQueryParams.AddIgnoredComponent(SkeletalMeshComponent);
+	if (SkeletalMeshComponent->GetOwner() != nullptr)
+		CollisionQueryParams.AddIgnoredActor(SkeletalMeshComponent->GetOwner());
+
+	const FVector ComponentLocation = SkeletalMeshComponent->GetComponentLocation();
+	const FVector TraceStart = ComponentLocation + FVector::UpVector * WorldGroundPlaneTraceStartHeight;
+	const FVector TraceEnd = ComponentLocation - FVector::UpVector * WorldGroundPlaneTraceDepth;
+
+	FHitResult HitResult;
+	if (World->LineTraceSingleByProfile(OUT HitResult, TraceStart, TraceEnd, WorldCollisionProfile, CollisionQueryParams) == false || HitResult.bStartPenetrating)
+	{
+		WorldGroundPlane.bValid = false;
+		return;
+	}
+
+	/// Keep the current plane for small changes so the solve does not jitter with every surface detail under the component
+	const FVector HitNormal = HitResult.ImpactNormal.GetSafeNormal();
+	if (WorldGroundPlane.bValid)
+	{
+		const float DistFromPlane = FMath::Abs(FVector::PointPlaneDist(HitResult.ImpactPoint, WorldGroundPlane.Location, WorldGroundPlane.Normal));
+		const float NormalAngleCos = HitNormal.Dot(WorldGroundPlane.Normal);
+		if (DistFromPlane <= WorldGroundPlaneUpdateDistance && NormalAngleCos >= FMath::Cos(FMath::DegreesToRadians(WorldGroundPlaneUpdateAngle)))
+			return;
+	}
+
+	WorldGroundPlane.Location = HitResult.ImpactPoint;
+	WorldGroundPlane.Normal = HitNormal;
+	WorldGroundPlane.QueryLocation = ComponentLocation;
+	WorldGroundPlane.bValid = (HitNormal.IsNearlyZero() == false);
+}
+
+void FLKAnimNode_AnimVerlet::UpdateWorldGeometryCache()
+{
+	if (bLODAllowWorldCollision == false)
+		return;
+
+	for (FLKAnimVerletConstraint_World& CurConstraint : WorldCollisionConstraints)
+	{
+		if (CurConstraint.bUseGeometryCache)
+			CurConstraint.UpdateGeometryCache();
+	}
+}
+
+void FLKAnimNode_AnimVerlet::SolveConstraints(float InDeltaTime)
+{
+#if LK_ENABLE_STAT
+	SCOPE_CYCLE_COUNTER(STAT_AnimVerlet_SolveConstraints);
+#endif
+
+	/// Solve Constraints
+	const int32 CurSolveIteration = FMath::Max(LODMaxSolveIteration > 0 ? FMath::Min(EffectiveSolveIteration, LODMaxSolveIteration) : EffectiveSolveIteration, 1);
+	const float SubStepDeltaTime = FMath::Max(bUseXPBDSolver ? InDeltaTime / CurSolveIteration : InDeltaTime, KINDA_SMALL_NUMBER);
+	for (int32 Iteration = 0; Iteration < CurSolveIteration; ++Iteration)
+	{
+		const bool bInitialUpdate = (Iteration == 0);
+		const bool bFinalizeUpdate = (Iteration == CurSolveIteration - 1);
 
 		/// Simulate each constraints
 		/// Solve order is important. Make a heuristic order by constraint priority.
@@ -2001,6 +3083,8 @@ void FLKAnimNode_AnimVerlet::SolveConstraints(float InDeltaTime)
 		#if LK_ENABLE_STAT
 			SCOPE_CYCLE_COUNTER(STAT_AnimVerlet_SolveConstraints_PinConstraints);
 		#endif
+			if (IsConstraintInSleepingIsland(PinConstraints[i]))
+				continue;
 			PinConstraints[i].Update(SubStepDeltaTime, bInitialUpdate, false);
 		}
 		for (int32 i = 0; i < DistanceConstraints.Num(); ++i)
@@ -2008,27 +3092,35 @@ void FLKAnimNode_AnimVerlet::SolveConstraints(float InDeltaTime)
 		#if LK_ENABLE_STAT
 			SCOPE_CYCLE_COUNTER(STAT_AnimVerlet_SolveConstraints_DistanceConstraints);
 		#endif
+			if (IsConstraintInSleepingIsland(DistanceConstraints[i]))
+				continue;
 			DistanceConstraints[i].Update(SubStepDeltaTime, bInitialUpdate, bFinalizeUpdate);
 		}
-		for (int32 i = 0; i < BendingConstraints.Num(); ++i)
+		for (int32 i = 0; i < BendingConstraints.Num() && bLODAllowBendingConstraints; ++i)
 		{
 		#if LK_ENABLE_STAT
 			SCOPE_CYCLE_COUNTER(STAT_AnimVerlet_SolveConstraints_BendingConstraints);
 		#endif
+			if (IsConstraintInSleepingIsland(BendingConstraints[i]))
+				continue;
 			BendingConstraints[i].Update(SubStepDeltaTime, bInitialUpdate, bFinalizeUpdate);
 		}
-		for (int32 i = 0; i < BendingConstraints_1D.Num(); ++i)
+		for (int32 i = 0; i < BendingConstraints_1D.Num() && bLODAllowBendingConstraints; ++i)
 		{
 			#if LK_ENABLE_STAT
 			SCOPE_CYCLE_COUNTER(STAT_AnimVerlet_SolveConstraints_BendingConstraints_1D);
 			#endif
+			if (IsConstraintInSleepingIsland(BendingConstraints_1D[i]))
+				continue;
 			BendingConstraints_1D[i].Update(SubStepDeltaTime, bInitialUpdate, bFinalizeUpdate);
 		}
-		for (int32 i = 0; i < FlatBendingConstraints.Num(); ++i)
+		for (int32 i = 0; i < FlatBendingConstraints.Num() && bLODAllowBendingConstraints; ++i)
 		{
 			#if LK_ENABLE_STAT
 			SCOPE_CYCLE_COUNTER(STAT_AnimVerlet_SolveConstraints_FlatBendingConstraints);
 			#endif
+			if (IsConstraintInSleepingIsland(FlatBendingConstraints[i]))
+				continue;
 			FlatBendingConstraints[i].Update(SubStepDeltaTime, bInitialUpdate, bFinalizeUpdate);
 		}
 		for (int32 i = 0; i < StraightenConstraints.Num(); ++i)
@@ -2036,13 +3128,17 @@ void FLKAnimNode_AnimVerlet::SolveConstraints(float InDeltaTime)
 		#if LK_ENABLE_STAT
 			SCOPE_CYCLE_COUNTER(STAT_AnimVerlet_SolveConstraints_StraightenConstraints);
 		#endif
+			if (IsConstraintInSleepingIsland(StraightenConstraints[i]))
+				continue;
 			StraightenConstraints[i].Update(SubStepDeltaTime, bInitialUpdate, bFinalizeUpdate);
 		}
-		for (int32 i = 0; i < BallSocketConstraints.Num(); ++i)
+		for (int32 i = 0; i < BallSocketConstraints.Num() && bLODAllowConeAngleConstraints; ++i)
 		{
 		#if LK_ENABLE_STAT
 			SCOPE_CYCLE_COUNTER(STAT_AnimVerlet_SolveConstraints_BallSocketConstraints);
 		#endif
+			if (IsConstraintInSleepingIsland(BallSocketConstraints[i]))
+				continue;
 			BallSocketConstraints[i].Update(SubStepDeltaTime, bInitialUpdate, bFinalizeUpdate);
 		}
 
@@ -2076,11 +3172,18 @@ void FLKAnimNode_AnimVerlet::SolveConstraints(float InDeltaTime)
 		#endif
 			BoxCollisionConstraints[i].Update(SubStepDeltaTime, bInitialUpdate, bFinalizeUpdate);
 		}
+		for (int32 i = 0; i < WorldCollisionConstraints.Num() && bLODAllowWorldCollision; ++i)
+		{
+		#if LK_ENABLE_STAT
+			SCOPE_CYCLE_COUNTER(STAT_AnimVerlet_SolveConstraints_WorldCollisionConstraints);
+		#endif
+			WorldCollisionConstraints[i].SolveGeometryCache(SubStepDeltaTime, bInitialUpdate, bFinalizeUpdate);
+		}
 		///-------------------------------------------------------------------------------------
 
 		///-------------------------------------------------------------------------------------
 		/// Self collision constratins
-		for (int32 i = 0; i < SelfCollisionConstraints.Num(); ++i)
+		for (int32 i = 0; i < SelfCollisionConstraints.Num() && bSignificanceAllowSelfCollision && bLODAllowSelfCollision; ++i)
 		{
 		#if LK_ENABLE_STAT
 			SCOPE_CYCLE_COUNTER(STAT_AnimVerlet_SolveConstraints_SelfCollisionConstraints);
@@ -2148,11 +3251,12 @@ void FLKAnimNode_AnimVerlet::SolveConstraints(float InDeltaTime)
 	}
 
 	/// Finalize special constraints
-	for (int32 i = 0; i < WorldCollisionConstraints.Num(); ++i)
+	for (int32 i = 0; i < WorldCollisionConstraints.Num() && bLODAllowWorldCollision; ++i)
 	{
 	#if LK_ENABLE_STAT
 		SCOPE_CYCLE_COUNTER(STAT_AnimVerlet_SolveConstraints_WorldCollisionConstraints);
 	#endif
+		WorldCollisionConstraints[i].bInertialFrame = bSimulateInInertialFrame;
 		WorldCollisionConstraints[i].Update(InDeltaTime, false, true);
 	}
 
@@ -2161,6 +3265,8 @@ void FLKAnimNode_AnimVerlet::SolveConstraints(float InDeltaTime)
 	#if LK_ENABLE_STAT
 		SCOPE_CYCLE_COUNTER(STAT_AnimVerlet_SolveConstraints_PinConstraints);
 	#endif
+		if (IsConstraintInSleepingIsland(PinConstraints[i]))
+			continue;
 		PinConstraints[i].Update(InDeltaTime, false, true);
 	}
 	for (int32 i = 0; i < FixedDistanceConstraints.Num(); ++i)
@@ -2168,6 +3274,8 @@ void FLKAnimNode_AnimVerlet::SolveConstraints(float InDeltaTime)
 	#if LK_ENABLE_STAT
 		SCOPE_CYCLE_COUNTER(STAT_AnimVerlet_SolveConstraints_FixedDistanceConstraints);
 	#endif
+		if (IsConstraintInSleepingIsland(FixedDistanceConstraints[i]))
+			continue;
 		FixedDistanceConstraints[i].Update(InDeltaTime, false, true);
 	}
 
@@ -2179,6 +3287,8 @@ void FLKAnimNode_AnimVerlet::SolveConstraints(float InDeltaTime)
 		#if LK_ENABLE_STAT
 			SCOPE_CYCLE_COUNTER(STAT_AnimVerlet_SolveConstraints_PinConstraints);
 		#endif
+			if (IsConstraintInSleepingIsland(PinConstraints[i]))
+				continue;
 			PinConstraints[i].BackwardUpdate(InDeltaTime, false, true);
 		}
 		for (int32 i = FixedDistanceConstraints.Num() - 1; i >= 0; --i)
@@ -2186,6 +3296,8 @@ void FLKAnimNode_AnimVerlet::SolveConstraints(float InDeltaTime)
 		#if LK_ENABLE_STAT
 			SCOPE_CYCLE_COUNTER(STAT_AnimVerlet_SolveConstraints_FixedDistanceConstraints);
 		#endif
+			if (IsConstraintInSleepingIsland(FixedDistanceConstraints[i]))
+				continue;
 			FixedDistanceConstraints[i].BackwardUpdate(InDeltaTime, false, true);
 		}
 
@@ -2194,6 +3306,8 @@ void FLKAnimNode_AnimVerlet::SolveConstraints(float InDeltaTime)
 		#if LK_ENABLE_STAT
 			SCOPE_CYCLE_COUNTER(STAT_AnimVerlet_SolveConstraints_PinConstraints);
 		#endif
+			if (IsConstraintInSleepingIsland(PinConstraints[i]))
+				continue;
 			PinConstraints[i].Update(InDeltaTime, false, true);
 		}
 		for (int32 i = 0; i < FixedDistanceConstraints.Num(); ++i)
@@ -2201,6 +3315,8 @@ void FLKAnimNode_AnimVerlet::SolveConstraints(float InDeltaTime)
 		#if LK_ENABLE_STAT
 			SCOPE_CYCLE_COUNTER(STAT_AnimVerlet_SolveConstraints_FixedDistanceConstraints);
 		#endif
+			if (IsConstraintInSleepingIsland(FixedDistanceConstraints[i]))
+				continue;
 			FixedDistanceConstraints[i].Update(InDeltaTime, false, true);
 		}
 	}
@@ -2223,10 +3339,15 @@ void FLKAnimNode_AnimVerlet::ApplyComponentInertiaTangentialDamping(float InDelt
 		? 0.0f
 		: FMath::Pow(BaseRetention, FMath::Max(InDeltaTime, 0.0f) * 60.0f);
 
-	for (FLKAnimVerletBone& ChildBone : SimulateBones)
+	/// Kept as a separate pass. A child adjusts its parent`s history, so a bone is only final after all of its children were visited
+	INC_DWORD_STAT(STAT_AnimVerlet_BonePasses);
+	for (int32 i = 0; i < SimulateBones.Num(); ++i)
 	{
+		FLKAnimVerletBone& ChildBone = SimulateBones[i];
 		if (ChildBone.HasParentBone() == false)
 			continue;
+		if (NumSleepingIslands > 0 && IsBoneIndexInSleepingIsland(i))
+			continue;
 
 		FLKAnimVerletBone& ParentBone = SimulateBones[ChildBone.ParentVerletBoneIndex];
 		const float ParentInvMass = ParentBone.IsPinned() ? 0.0f : ParentBone.InvMass;
@@ -2252,80 +3373,323 @@ void FLKAnimNode_AnimVerlet::ApplyComponentInertiaTangentialDamping(float InDelt
 	}
 }
 
-void FLKAnimNode_AnimVerlet::UpdateSleep(float InDeltaTime)
+void FLKAnimNode_AnimVerlet::UpdateSleep(IN OUT FLKAnimVerletBone& CurVerletBone, float InDeltaTime, float SleepThresholdSQ, float WakeUpThresholdSQ)
 {
-#if LK_ENABLE_STAT
-	SCOPE_CYCLE_COUNTER(STAT_AnimVerlet_UpdateSleep);
-#endif
-
-	const float SleepThresholdSQ = SleepDeltaThreshold * SleepDeltaThreshold;
-	const float WakeUpThresholdSQ = WakeUpDeltaThreshold * WakeUpDeltaThreshold;
-	for (int32 i = 0; i < SimulateBones.Num(); ++i)
+	bool bForceWakeUp = false;
+	if (bIgnoreSleepWhenParentWakedUp && CurVerletBone.HasParentBone())
 	{
-		FLKAnimVerletBone& CurVerletBone = SimulateBones[i];
-
-		bool bForceWakeUp = false;
-		if (bIgnoreSleepWhenParentWakedUp && CurVerletBone.HasParentBone())
-		{
-			const FLKAnimVerletBone& ParentVerletBone = SimulateBones[CurVerletBone.ParentVerletBoneIndex];
-			if (ParentVerletBone.IsSleep() == false)
-				bForceWakeUp = true;
-		}
+		const FLKAnimVerletBone& ParentVerletBone = SimulateBones[CurVerletBone.ParentVerletBoneIndex];
+		if (ParentVerletBone.IsSleep() == false)
+			bForceWakeUp = true;
+	}
 
-		if (bForceWakeUp)
+	if (bForceWakeUp)
+	{
+		CurVerletBone.WakeUp();
+	}
+	else
+	{
+		const float CurDeltaSQ = (CurVerletBone.Location - CurVerletBone.PrevLocation).SizeSquared();
+		if (CurVerletBone.IsSleep())
 		{
-			CurVerletBone.WakeUp();
+			if (CurDeltaSQ >= WakeUpThresholdSQ)
+			{
+				CurVerletBone.WakeUp();
+			}
+			else
+			{
+				CurVerletBone.Sleep();
+			}
 		}
 		else
 		{
-			const float CurDeltaSQ = (CurVerletBone.Location - CurVerletBone.PrevLocation).SizeSquared();
-			if (CurVerletBone.IsSleep())
+			if (CurDeltaSQ <= SleepThresholdSQ)
 			{
-				if (CurDeltaSQ >= WakeUpThresholdSQ)
-				{
-					CurVerletBone.WakeUp();
-				}
-				else
+				CurVerletBone.SleepTriggerElapsedTime += InDeltaTime;
+				if (CurVerletBone.SleepTriggerElapsedTime >= SleepTriggerDuration)
 				{
 					CurVerletBone.Sleep();
 				}
 			}
 			else
 			{
-				if (CurDeltaSQ <= SleepThresholdSQ)
-				{
-					CurVerletBone.SleepTriggerElapsedTime += InDeltaTime;
-					if (CurVerletBone.SleepTriggerElapsedTime >= SleepTriggerDuration)
-					{
-						CurVerletBone.Sleep();
-					}
-				}
-				else
-				{
-					CurVerletBone.WakeUp();
-				}
+				CurVerletBone.WakeUp();
 			}
 		}
 	}
 }
 
+void FLKAnimNode_AnimVerlet::BuildSleepIslands()
+{
+	SleepIslands.Reset();
+	SimulateBoneIslandIndexes.Reset();
+	NumSleepingIslands = 0;
+	if (bUseSleep == false || bUseIslandSleep == false || SimulateBones.Num() == 0)
+		return;
+
+	/// Union-find over every bone to bone link
+	TArray<int32> UnionParents;
+	UnionParents.SetNumUninitialized(SimulateBones.Num());
+	for (int32 i = 0; i < UnionParents.Num(); ++i)
+		UnionParents[i] = i;
+
+	auto FindRoot = [&UnionParents](int32 Index) {
+		while (UnionParents[Index] != Index)
+		{
+			UnionParents[Index] = UnionParents[UnionParents[Index]];
+			Index = UnionParents[Index];
+		}
+		return Index;
+	};
+	auto UnionBoneIndexes = [&UnionParents, &FindRoot](int32 IndexA, int32 IndexB) {
+		if (IndexA == INDEX_NONE || IndexB == INDEX_NONE)
+			return;
+		const int32 RootA = FindRoot(IndexA);
+		const int32 RootB = FindRoot(IndexB);
+		if (RootA != RootB)
+			UnionParents[RootB] = RootA;
+	};
+	auto UnionBones = [this, &UnionBoneIndexes](const FLKAnimVerletBone* BoneA, const FLKAnimVerletBone* BoneB) {
+		UnionBoneIndexes(GetSimulateBoneIndex(BoneA), GetSimulateBoneIndex(BoneB));
+	};
+
+	for (int32 i = 0; i < SimulateBones.Num(); ++i)
+	{
+		if (SimulateBones[i].HasParentBone())
+			UnionBoneIndexes(i, SimulateBones[i].ParentVerletBoneIndex);
+	}
+	for (const FLKAnimVerletConstraint_Distance& CurConstraint : DistanceConstraints)
+		UnionBones(CurConstraint.BoneA, CurConstraint.BoneB);
+	for (const FLKAnimVerletConstraint_IsometricBending& CurConstraint : BendingConstraints)
+	{
+		UnionBones(CurConstraint.BoneA, CurConstraint.BoneB);
+		UnionBones(CurConstraint.BoneA, CurConstraint.BoneC);
+		UnionBones(CurConstraint.BoneA, CurConstraint.BoneD);
+	}
+	for (const FLKAnimVerletConstraint_Bending_1D& CurConstraint : BendingConstraints_1D)
+	{
+		UnionBones(CurConstraint.BoneA, CurConstraint.BoneB);
+		UnionBones(CurConstraint.BoneA, CurConstraint.BoneC);
+	}
+	for (const FLKAnimVerletConstraint_FlatBending& CurConstraint : FlatBendingConstraints)
+	{
+		UnionBones(CurConstraint.BoneA, CurConstraint.BoneB);
+		UnionBones(CurConstraint.BoneA, CurConstraint.BoneC);
+		UnionBones(CurConstraint.BoneA, CurConstraint.BoneD);
+	}
+	for (const FLKAnimVerletConstraint_Straighten& CurConstraint : StraightenConstraints)
+	{
+		UnionBones(CurConstraint.BoneA, CurConstraint.BoneB);
+		UnionBones(CurConstraint.BoneA, CurConstraint.BoneC);
+	}
+	for (const FLKAnimVerletConstraint_FixedDistance& CurConstraint : FixedDistanceConstraints)
+		UnionBones(CurConstraint.BoneA, CurConstraint.BoneB);
+	for (const FLKAnimVerletConstraint_BallSocket& CurConstraint : BallSocketConstraints)
+		UnionBones(CurConstraint.BoneA, CurConstraint.BoneB);
+
+	/// Self collision can couple any two bones at runtime
+	if (SelfCollisionConstraints.Num() > 0)
+	{
+		for (int32 i = 1; i < SimulateBones.Num(); ++i)
+			UnionBoneIndexes(0, i);
+	}
+
+	TMap<int32, int32> IslandIndexByRoot;
+	SimulateBoneIslandIndexes.SetNumUninitialized(SimulateBones.Num());
+	for (int32 i = 0; i < SimulateBones.Num(); ++i)
+	{
+		const int32 Root = FindRoot(i);
+		int32* FoundIslandIndex = IslandIndexByRoot.Find(Root);
+		const int32 IslandIndex = (FoundIslandIndex != nullptr) ? *FoundIslandIndex : IslandIndexByRoot.Add(Root, SleepIslands.AddDefaulted());
+		SleepIslands[IslandIndex].BoneIndexes.Emplace(i);
+		SimulateBoneIslandIndexes[i] = IslandIndex;
+	}
+}
+
+void FLKAnimNode_AnimVerlet::UpdateSleepIslandsWakeUp(bool bComponentFrameMoved, float WakeUpThresholdSQ)
+{
+	/// Changed forces or continuous wind would be lost on a sleeping island
+	const bool bWakeUpAll = FrameUpdateParam.bForceChanged || FrameUpdateParam.bHasContinuousForce;
+	bool bAnchorMoved = false;
+	for (const FLKAnimVerletBone& CurAnchorBone : CustomDistanceConstraintBones)
+		bAnchorMoved |= ((CurAnchorBone.PoseLocation - CurAnchorBone.PrevPoseLocation).SizeSquared() >= WakeUpThresholdSQ);
+
+	if (bWakeUpAll || bAnchorMoved)
+	{
+		WakeUpSleepIslands();
+		return;
+	}
+
+	const FLKAnimVerletUpdateParam& VerletUpdateParam = FrameUpdateParam.UpdateParam;
+	for (FLKAnimVerletSleepIsland& CurIsland : SleepIslands)
+	{
+		if (CurIsland.bSleep == false)
+			continue;
+
+		for (const int32 CurBoneIndex : CurIsland.BoneIndexes)
+		{
+			const FLKAnimVerletBone& CurVerletBone = SimulateBones[CurBoneIndex];
+			const bool bPoseMoved = (CurVerletBone.PoseLocation - CurVerletBone.PrevPoseLocation).SizeSquared() >= WakeUpThresholdSQ;
+			/// Pinned bones follow the pose exactly, so slow animation drift accumulates here
+			const bool bPinDrifted = CurVerletBone.IsPinned() && (CurVerletBone.PoseLocation - CurVerletBone.Location).SizeSquared() >= WakeUpThresholdSQ;
+			const bool bFrameMoved = bComponentFrameMoved && VerletUpdateParam.MakeComponentFrameDisplacement(CurVerletBone.Location).SizeSquared() >= WakeUpThresholdSQ;
+			if (bPoseMoved || bPinDrifted || bFrameMoved)
+			{
+				WakeUpSleepIsland(CurIsland);
+				break;
+			}
+		}
+	}
+}
+
+void FLKAnimNode_AnimVerlet::WakeUpSleepIslandsNearMovingColliders()
+{
+	/// Nothing to wake. The islands falling asleep were settled against the current colliders, so the next frame starts a new history.
+	if (NumSleepingIslands == 0)
+	{
+		PrevColliderBounds.Reset();
+		return;
+	}
+
+	/// Local colliders are rebuilt every frame, so their bounds of the last frame are kept here.
+	/// Planes are skipped(mostly unbounded), world collision has its own stationary sweep skip.
+	CurColliderBounds.Reset();
+	for (const FLKAnimVerletConstraint_Sphere& CurConstraint : SphereCollisionConstraints)
+		CurColliderBounds.Emplace(CurConstraint.MakeBound());
+	for (const FLKAnimVerletConstraint_Capsule& CurConstraint : CapsuleCollisionConstraints)
+		CurColliderBounds.Emplace(CurConstraint.MakeBound());
+	for (const FLKAnimVerletConstraint_Box& CurConstraint : BoxCollisionConstraints)
+		CurColliderBounds.Emplace(CurConstraint.MakeBound());
+
+	/// No history yet: the bounds of this frame become the reference
+	if (PrevColliderBounds.Num() > 0)
+	{
+		const bool bSameColliders = (PrevColliderBounds.Num() == CurColliderBounds.Num());
+		for (int32 i = 0; i < CurColliderBounds.Num() && NumSleepingIslands > 0; ++i)
+		{
+			/// A collider resting next to an island must not keep it awake
+			if (bSameColliders && CurColliderBounds[i].IsNearlyEqual(PrevColliderBounds[i], WakeUpDeltaThreshold))
+				continue;
+
+			FLKAnimVerletBound SweptBound = CurColliderBounds[i];
+			if (bSameColliders)
+				SweptBound.Expand(PrevColliderBounds[i]);
+			SweptBound.Expand(SleepIslandColliderWakeMargin);
+
+			for (FLKAnimVerletSleepIsland& CurIsland : SleepIslands)
+			{
+				if (CurIsland.bSleep && CurIsland.Bound.IsIntersect(SweptBound))
+					WakeUpSleepIsland(IN OUT CurIsland);
+			}
+		}
+	}
+	Swap(PrevColliderBounds, CurColliderBounds);
+}
+
+void FLKAnimNode_AnimVerlet::UpdateSleepingBoneStat(int32 NumSleepingBones)
+{
+	SleepingBoneFraction = (SimulateBones.Num() > 0) ? static_cast<float>(NumSleepingBones) / static_cast<float>(SimulateBones.Num()) : 0.0f;
+	INC_DWORD_STAT_BY(STAT_AnimVerlet_SleepingBones, NumSleepingBones);
+	INC_DWORD_STAT_BY(STAT_AnimVerlet_SimulatedBones, SimulateBones.Num());
+	SET_FLOAT_STAT(STAT_AnimVerlet_SleepingBoneFraction, SleepingBoneFraction);
+}
+
+void FLKAnimNode_AnimVerlet::WakeUpSleepIsland(IN OUT FLKAnimVerletSleepIsland& InIsland)
+{
+	if (InIsland.bSleep == false)
+		return;
+
+	InIsland.bSleep = false;
+	--NumSleepingIslands;
+	for (const int32 CurBoneIndex : InIsland.BoneIndexes)
+		SimulateBones[CurBoneIndex].WakeUp();
+}
+
+void FLKAnimNode_AnimVerlet::WakeUpSleepIslands()
+{
+	for (FLKAnimVerletSleepIsland& CurIsland : SleepIslands)
+		WakeUpSleepIsland(CurIsland);
+}
+
+int32 FLKAnimNode_AnimVerlet::GetSimulateBoneIndex(const FLKAnimVerletBone* InBone) const
+{
+	const FLKAnimVerletBone* BoneData = SimulateBones.GetData();
+	if (InBone == nullptr || BoneData == nullptr || InBone < BoneData || InBone >= BoneData + SimulateBones.Num())
+		return INDEX_NONE;
+	return static_cast<int32>(InBone - BoneData);
+}
+
 void FLKAnimNode_AnimVerlet::PostUpdateBones(float InDeltaTime)
 {
 #if LK_ENABLE_STAT
 	SCOPE_CYCLE_COUNTER(STAT_AnimVerlet_PostUpdateBones);
 #endif
 
-	/// PostUpdate each simulating bones
+	/// Sleep and PostUpdate each simulating bones in a single pass.
+	/// Parents are always stored before their children, so a parent`s sleep state is already final when its children read it.
+	INC_DWORD_STAT(STAT_AnimVerlet_BonePasses);
+	const float SleepThresholdSQ = SleepDeltaThreshold * SleepDeltaThreshold;
+	const float WakeUpThresholdSQ = WakeUpDeltaThreshold * WakeUpDeltaThreshold;
+	for (FLKAnimVerletSleepIsland& CurIsland : SleepIslands)
+		CurIsland.NumAwakeBones = 0;
+
+	int32 NumSleepingBones = 0;
 	for (int32 i = 0; i < SimulateBones.Num(); ++i)
 	{
 		FLKAnimVerletBone& CurVerletBone = SimulateBones[i];
+		if (NumSleepingIslands > 0 && IsBoneIndexInSleepingIsland(i))
+		{
+			/// Collision constraints still visit every bone. Undo their corrections like a sleeping bone does
+			CurVerletBone.Sleep();
+			CurVerletBone.PostUpdate(InDeltaTime);
+			++NumSleepingBones;
+			continue;
+		}
+
+		if (bUseSleep)
+			UpdateSleep(IN OUT CurVerletBone, InDeltaTime, SleepThresholdSQ, WakeUpThresholdSQ);
+
 		CurVerletBone.PostUpdate(InDeltaTime);
+
+		if (CurVerletBone.IsSleep())
+			++NumSleepingBones;
+		else if (SimulateBoneIslandIndexes.IsValidIndex(i))
+			++SleepIslands[SimulateBoneIslandIndexes[i]].NumAwakeBones;
+	}
+	UpdateSleepingBoneStat(NumSleepingBones);
+
+	/// An island whose bones all sleep leaves the simulation until a wake event
+	if (FrameUpdateParam.bHasContinuousForce == false)
+	{
+		for (FLKAnimVerletSleepIsland& CurIsland : SleepIslands)
+		{
+			if (CurIsland.bSleep || CurIsland.NumAwakeBones > 0)
+				continue;
+
+			CurIsland.bSleep = true;
+			++NumSleepingIslands;
+
+			CurIsland.Bound = SimulateBones[CurIsland.BoneIndexes[0]].MakeBound();
+			for (const int32 CurBoneIndex : CurIsland.BoneIndexes)
+				CurIsland.Bound.Expand(SimulateBones[CurBoneIndex].MakeBound());
+		}
 	}
 
+	UpdateExcludedBonesAndRotations();
+}
+
+void FLKAnimNode_AnimVerlet::UpdateExcludedBonesAndRotations()
+{
 	/// Calculate ExcludedBone`s Location(bStraightenExcludedBonesByParent)
 	for (int32 i = 0; i < ExcludedBones.Num(); ++i)
 	{
 		FLKAnimVerletExcludedBone& CurExcludedVerletBone = ExcludedBones[i];
+		if (CurExcludedVerletBone.IsInterpolated())
+		{
+			/// Skipped by a reduced chain resolution(LODFeatureOverrides)
+			CurExcludedVerletBone.Location = FMath::Lerp(SimulateBones[CurExcludedVerletBone.ParentVerletBoneIndex].Location, SimulateBones[CurExcludedVerletBone.InterpolationChildVerletBoneIndex].Location, CurExcludedVerletBone.InterpolationAlpha);
+			continue;
+		}
 		if (CurExcludedVerletBone.bStraightenExcludedBonesByParent == false)
 			continue;
 
@@ -2466,6 +3830,83 @@ void FLKAnimNode_AnimVerlet::PostUpdateBones(float InDeltaTime)
 	}
 }
 
+void FLKAnimNode_AnimVerlet::UpdateProceduralSway(float InDeltaTime, const FTransform& ComponentTransform, const FTransform& PrevComponentTransform)
+{
+#if LK_ENABLE_STAT
+	SCOPE_CYCLE_COUNTER(STAT_AnimVerlet_UpdateProceduralSway);
+#endif
+
+	/// Stiffness and Damping are tuned for the Verlet solve. Map them onto a natural frequency and a damping ratio with a similar look.
+	/// Damping is the velocity retained per frame at DampingCorrectionTargetFrameRate.
+	const float NaturalFrequency = UE_TWO_PI * FMath::Lerp(LKG_SWAY_MIN_FREQUENCY, LKG_SWAY_MAX_FREQUENCY, FMath::Clamp(Stiffness, 0.0f, 1.0f));
+	const float DampingFrameRate = DampingCorrectionTargetFrameRate > 0.0f ? DampingCorrectionTargetFrameRate : 60.0f;
+	const float DecayRate = -FMath::Loge(FMath::Clamp(Damping, 0.01f, 1.0f)) * DampingFrameRate;
+	const float DampingRatio = FMath::Clamp(DecayRate / (2.0f * NaturalFrequency), LKG_SWAY_MIN_DAMPING_RATIO, 1.0f);
+	const float InvSquaredFrequency = 1.0f / (NaturalFrequency * NaturalFrequency);
+	const float InvDeltaTime = 1.0f / InDeltaTime;
+
+	const FVector GravityVector = (bGravityInWorldSpace == false || Gravity.IsNearlyZero(KINDA_SMALL_NUMBER)) ? Gravity : ComponentTransform.InverseTransformVector(Gravity);
+	const FVector ComponentMoveDiff = ComponentTransform.GetLocation() - PrevComponentTransform.GetLocation();
+	const FQuat ComponentRotDiff = ComponentTransform.GetRotation() * PrevComponentTransform.GetRotation().Inverse();
+	const bool bIgnoreInertia = (bIgnoreSuddenMoveInertia && ComponentMoveDiff.SizeSquared() > FMath::Square(MoveInertiaIgnoreThreshold))
+								|| (bIgnoreSuddenRotationInertia && FMath::RadiansToDegrees(ComponentRotDiff.GetAngle()) > RotationInertiaIgnoreDegrees);
+	const FVector ComponentMoveVelocity = ComponentMoveDiff * InvDeltaTime;
+
+	const bool bInitializeState = (bProceduralSwayStateValid == false || SwayStates.Num() != SimulateBones.Num());
+	if (bInitializeState)
+		SwayStates.SetNum(SimulateBones.Num());
+
+	/// Parents are stored before their children, so a parent`s swayed location is final when its child reads it
+	for (int32 i = 0; i < SimulateBones.Num(); ++i)
+	{
+		FLKAnimVerletBone& CurVerletBone = SimulateBones[i];
+		FLKAnimVerletSwayState& CurSwayState = SwayStates[i];
+
+		/// World space velocity of the pose point caused by the component movement. Its change is the inertial acceleration.
+		const FVector PoseRotationVelocity = (ComponentTransform.GetRotation().RotateVector(CurVerletBone.PoseLocation) - PrevComponentTransform.GetRotation().RotateVector(CurVerletBone.PoseLocation)) * InvDeltaTime;
+		const FVector InertialVelocity = ComponentMoveVelocity * MoveInertiaScale + PoseRotationVelocity * RotationInertiaScale;
+
+		if (CurVerletBone.HasParentBone() == false || CurVerletBone.bPinned)
+		{
+			CurVerletBone.Location = CurVerletBone.PoseLocation;
+			CurSwayState = FLKAnimVerletSwayState();
+			CurSwayState.PrevInertialVelocity = InertialVelocity;
+			continue;
+		}
+
+		const FLKAnimVerletBone& ParentVerletBone = SimulateBones[CurVerletBone.ParentVerletBoneIndex];
+		const FVector PoseVectorFromParent = CurVerletBone.PoseLocation - ParentVerletBone.PoseLocation;
+		const float SegmentLength = PoseVectorFromParent.Size();
+		if (bInitializeState)
+		{
+			/// Continue from the last result. The parent has already moved on this frame, PrevLocation is where it was.
+			CurSwayState.Offset = (CurVerletBone.Location - ParentVerletBone.PrevLocation) - PoseVectorFromParent;
+			CurSwayState.Velocity = CurVerletBone.Velocity - ParentVerletBone.Velocity;
+			CurSwayState.PrevInertialVelocity = InertialVelocity;
+		}
+
+		FVector Acceleration = GravityVector;
+		if (bIgnoreInertia == false)
+			Acceleration -= ComponentTransform.InverseTransformVectorNoScale((InertialVelocity - CurSwayState.PrevInertialVelocity) * InvDeltaTime);
+		CurSwayState.PrevInertialVelocity = InertialVelocity;
+
+		LkAnimVerlet::StepSpringDamper(IN OUT CurSwayState.Offset, IN OUT CurSwayState.Velocity, Acceleration * InvSquaredFrequency, NaturalFrequency, DampingRatio, InDeltaTime);
+		CurSwayState.Offset = CurSwayState.Offset.GetClampedToMaxSize(SegmentLength);
+
+		/// Keep the segment length. Only the swing of the segment is visible.
+		const FVector SwayVectorFromParent = PoseVectorFromParent + CurSwayState.Offset;
+		const FVector SwayDirFromParent = SwayVectorFromParent.IsNearlyZero(KINDA_SMALL_NUMBER) ? PoseVectorFromParent.GetSafeNormal() : SwayVectorFromParent.GetUnsafeNormal();
+		CurVerletBone.Location = ParentVerletBone.Location + SwayDirFromParent * SegmentLength;
+	}
+
+	/// Velocity keeps the next full simulation step continuous
+	for (FLKAnimVerletBone& CurVerletBone : SimulateBones)
+		CurVerletBone.PostUpdate(InDeltaTime);
+	bProceduralSwayStateValid = true;
+
+	UpdateExcludedBonesAndRotations();
+}
+
 void FLKAnimNode_AnimVerlet::ApplyResult(OUT TArray<FBoneTransform>& OutBoneTransforms, FComponentSpacePoseContext& PoseContext, const FBoneContainer& BoneContainer)
 {
 #if LK_ENABLE_STAT
@@ -2498,8 +3939,14 @@ void FLKAnimNode_AnimVerlet::ApplyResult(OUT TArray<FBoneTransform>& OutBoneTran
 		{
 			const FTransform& PoseBoneT = PoseContext.Pose.GetComponentSpaceTransform(BonePoseIndex);
 			const FTransform SimulatedBoneT(CurBone->Rotation, CurBone->Location, PoseBoneT.GetScale3D());
+			FTransform BlendSourceT = PoseBoneT;
+			if (OutputBlendSourceOffsets.IsValidIndex(i))
+			{
+				BlendSourceT = OutputBlendSourceOffsets[i] * PoseBoneT;
+				BlendSourceT.SetScale3D(PoseBoneT.GetScale3D());
+			}
 			FTransform ResultBoneT;
-			ResultBoneT.Blend(PoseBoneT, SimulatedBoneT, FMath::Clamp(OutputBlendAlpha, 0.0f, 1.0f));
+			ResultBoneT.Blend(BlendSourceT, SimulatedBoneT, FMath::Clamp(OutputBlendAlpha, 0.0f, 1.0f));
 			OutBoneTransforms.Emplace(FBoneTransform(BonePoseIndex, ResultBoneT));
 		}
 	}
@@ -2508,9 +3955,370 @@ void FLKAnimNode_AnimVerlet::ApplyResult(OUT TArray<FBoneTransform>& OutBoneTran
 	OutBoneTransforms.Sort(FCompareBoneTransformIndex());
 }
 
+void FLKAnimNode_AnimVerlet::BuildSleepingResultCache(const TArray<FBoneTransform>& InBoneTransforms, FComponentSpacePoseContext& PoseContext, const FBoneContainer& BoneContainer)
+{
+	bHasSleepingResultCache = false;
+	if (bUseSleep == false || bUseSleepingResultCache == false || bLocalColliderDirty)
+		return;
+	if (SimulateBones.Num() == 0 || SleepingBoneFraction < 1.0f || OutputBlendAlpha < 1.0f)
+		return;
+
+	SleepingResultCache.Reset(InBoneTransforms.Num());
+	for (const FBoneTransform& CurBoneTransform : InBoneTransforms)
+	{
+		FLKAnimVerletCachedBoneResult& CachedResult = SleepingResultCache.Emplace_GetRef();
+		CachedResult.BonePoseIndex = CurBoneTransform.BoneIndex;
+		CachedResult.PoseT = PoseContext.Pose.GetComponentSpaceTransform(CurBoneTransform.BoneIndex);
+		CachedResult.PoseOffset = CurBoneTransform.Transform.GetRelativeTransform(CachedResult.PoseT);
+	}
+
+	/// Colliders attached to other bones(arms, legs) must still wake the node.
+	/// Dynamic world space colliders can be moved from outside at any time, so they disable the cache.
+	SleepingResultColliderPoses.Reset();
+	bool bHasMovableWorldCollider = false;
+	auto CacheColliderPoses = [this, &PoseContext, &BoneContainer, &bHasMovableWorldCollider](const auto& InShapes, bool bDynamicShapes) {
+		for (const auto& CurShape : InShapes)
+		{
+			if (CurShape.bUseAbsoluteWorldTransform)
+			{
+				bHasMovableWorldCollider |= bDynamicShapes;
+				continue;
+			}
+
+			const FCompactPoseBoneIndex PoseBoneIndex = CurShape.AttachedBone.GetCompactPoseIndex(BoneContainer);
+			if (PoseBoneIndex == INDEX_NONE)
+				continue;
+
+			FLKAnimVerletCachedBoneResult& CachedPose = SleepingResultColliderPoses.Emplace_GetRef();
+			CachedPose.BonePoseIndex = PoseBoneIndex;
+			CachedPose.PoseT = PoseContext.Pose.GetComponentSpaceTransform(PoseBoneIndex);
+		}
+	};
+	CacheColliderPoses(SimulatingCollisionShapes.SphereCollisionShapes, false);
+	CacheColliderPoses(SimulatingCollisionShapes.CapsuleCollisionShapes, false);
+	CacheColliderPoses(SimulatingCollisionShapes.BoxCollisionShapes, false);
+	CacheColliderPoses(SimulatingCollisionShapes.PlaneCollisionShapes, false);
+	CacheColliderPoses(DynamicCollisionShapes.SphereCollisionShapes, true);
+	CacheColliderPoses(DynamicCollisionShapes.CapsuleCollisionShapes, true);
+	CacheColliderPoses(DynamicCollisionShapes.BoxCollisionShapes, true);
+	CacheColliderPoses(DynamicCollisionShapes.PlaneCollisionShapes, true);
+	if (bHasMovableWorldCollider)
+		return;
+
+	SleepingResultCacheGravity = Gravity;
+	SleepingResultCacheExternalForce = ExternalForce;
+	bHasSleepingResultCache = true;
+}
+
+bool FLKAnimNode_AnimVerlet::IsCachedPoseValid(const FLKAnimVerletCachedBoneResult& InCachedResult, FComponentSpacePoseContext& PoseContext) const
+{
+	const FTransform& CurPoseT = PoseContext.Pose.GetComponentSpaceTransform(InCachedResult.BonePoseIndex);
+	if ((CurPoseT.GetLocation() - InCachedResult.PoseT.GetLocation()).SizeSquared() >= WakeUpDeltaThreshold * WakeUpDeltaThreshold)
+		return false;
+	return (FMath::RadiansToDegrees(CurPoseT.GetRotation().AngularDistance(InCachedResult.PoseT.GetRotation())) <= SleepingResultCacheRotationTolerance);
+}
+
+bool FLKAnimNode_AnimVerlet::ApplySleepingResultCache(OUT TArray<FBoneTransform>& OutBoneTransforms, FComponentSpacePoseContext& PoseContext, const FBoneContainer& BoneContainer, const FTransform& ComponentTransform)
+{
+	if (bHasSleepingResultCache == false)
+		return false;
+	if (bUseSleep == false || bUseSleepingResultCache == false || bLocalColliderDirty)
+		return false;
+
+	/// Same wake events as the simulation: forces, wind, component motion
+	if (Gravity.Equals(SleepingResultCacheGravity, KINDA_SMALL_NUMBER) == false || ExternalForce.Equals(SleepingResultCacheExternalForce, KINDA_SMALL_NUMBER) == false)
+		return false;
+	if (RandomWindDirection.IsNearlyZero(KINDA_SMALL_NUMBER) == false && RandomWindSizeMax > 0.0f)
+		return false;
+	for (const FLKAnimVerletRandomForceSetting& CurWind : AdditionalRandomWinds)
+	{
+		if (CurWind.RandomForceDirection.IsNearlyZero(KINDA_SMALL_NUMBER) == false && CurWind.RandomForceSizeMax > 0.0f)
+			return false;
+	}
+	if (bAdjustWindComponent)
+	{
+		for (const FVector& CurWindVelocity : CachedWindVelocities)
+		{
+			if (CurWindVelocity.IsNearlyZero(KINDA_SMALL_NUMBER) == false)
+				return false;
+		}
+	}
+	if ((ComponentTransform.GetLocation() - PrevComponentT.GetLocation()).SizeSquared() >= WakeUpDeltaThreshold * WakeUpDeltaThreshold)
+		return false;
+	if (FMath::RadiansToDegrees(ComponentTransform.GetRotation().AngularDistance(PrevComponentT.GetRotation())) > SleepingResultCacheRotationTolerance)
+		return false;
+
+	/// Guard against a required bones change that did not go through InitializeBoneReferences
+	const int32 NumPoseBones = BoneContainer.GetCompactPoseNumBones();
+
+	/// Rotations are only recomputed by the simulation once a pose moved beyond the tolerance since the cache was built
+	for (const FLKAnimVerletCachedBoneResult& CachedPose : SleepingResultColliderPoses)
+	{
+		if (CachedPose.BonePoseIndex.GetInt() >= NumPoseBones || IsCachedPoseValid(CachedPose, PoseContext) == false)
+			return false;
+	}
+	for (const FLKAnimVerletCachedBoneResult& CachedResult : SleepingResultCache)
+	{
+		if (CachedResult.BonePoseIndex.GetInt() >= NumPoseBones || IsCachedPoseValid(CachedResult, PoseContext) == false)
+			return false;
+	}
+
+	/// Already sorted, no blend
+	OutBoneTransforms.Reserve(OutBoneTransforms.Num() + SleepingResultCache.Num());
+	for (const FLKAnimVerletCachedBoneResult& CachedResult : SleepingResultCache)
+	{
+		const FTransform& CurPoseT = PoseContext.Pose.GetComponentSpaceTransform(CachedResult.BonePoseIndex);
+		OutBoneTransforms.Emplace(FBoneTransform(CachedResult.BonePoseIndex, CachedResult.PoseOffset * CurPoseT));
+	}
+
+	INC_DWORD_STAT(STAT_AnimVerlet_SleepingResultCacheHits);
+	UpdateSleepingBoneStat(SimulateBones.Num());
+	return true;
+}
+
+uint32 FLKAnimNode_AnimVerlet::CalculateShareSettingsHash() const
+{
+	/// Every hashable editable setting. Per instance values do not split the groups.
+	uint32 Hash = 0;
+	for (TFieldIterator<FProperty> PropertyIt(FLKAnimNode_AnimVerlet::StaticStruct()); PropertyIt; ++PropertyIt)
+	{
+		const FProperty* CurProperty = *PropertyIt;
+		if (CurProperty->HasAnyPropertyFlags(CPF_Edit) == false || CurProperty->HasAllPropertyFlags(CPF_HasGetValueTypeHash) == false)
+			continue;
+		if (CurProperty->GetFName() == GET_MEMBER_NAME_CHECKED(FLKAnimNode_AnimVerlet, SharePhaseOffsetFrames) || CurProperty->GetFName() == GET_MEMBER_NAME_CHECKED(FLKAnimNode_AnimVerlet, BudgetPriority))
+			continue;
+
+		Hash = HashCombine(Hash, CurProperty->GetValueTypeHash(CurProperty->ContainerPtrToValuePtr<void>(this)));
+	}
+
+	/// Bone chain settings are not hashable as a whole. The chain roots identify them.
+	for (const FLKAnimVerletBoneSetting& CurBoneSetting : VerletBones)
+		Hash = HashCombine(Hash, GetTypeHash(CurBoneSetting.RootBone.BoneName));
+	return Hash;
+}
+
+uint32 FLKAnimNode_AnimVerlet::CalculateTopologySettingsHash() const
+{
+	/// Every setting BuildSimulationTopology reads. Hashed from the exported text so the hash is the same in every run and can be saved in the asset.
+	static const FName TopologySettingNames[] = {
+		GET_MEMBER_NAME_CHECKED(FLKAnimNode_AnimVerlet, VerletBones),
+		GET_MEMBER_NAME_CHECKED(FLKAnimNode_AnimVerlet, bSubDivideBones),
+		GET_MEMBER_NAME_CHECKED(FLKAnimNode_AnimVerlet, NumSubDividedBone),
+		GET_MEMBER_NAME_CHECKED(FLKAnimNode_AnimVerlet, bMakeFakeTipBone),
+		GET_MEMBER_NAME_CHECKED(FLKAnimNode_AnimVerlet, FakeTipBoneLength),
+		GET_MEMBER_NAME_CHECKED(FLKAnimNode_AnimVerlet, bLockTipBone),
+		GET_MEMBER_NAME_CHECKED(FLKAnimNode_AnimVerlet, TipBoneLockMargin),
+		GET_MEMBER_NAME_CHECKED(FLKAnimNode_AnimVerlet, StartBoneLockMargin),
+		GET_MEMBER_NAME_CHECKED(FLKAnimNode_AnimVerlet, bUseXPBDSolver),
+		GET_MEMBER_NAME_CHECKED(FLKAnimNode_AnimVerlet, Stiffness),
+		GET_MEMBER_NAME_CHECKED(FLKAnimNode_AnimVerlet, InvCompliance),
+		GET_MEMBER_NAME_CHECKED(FLKAnimNode_AnimVerlet, bStretchEachBone),
+		GET_MEMBER_NAME_CHECKED(FLKAnimNode_AnimVerlet, StretchStrength),
+		GET_MEMBER_NAME_CHECKED(FLKAnimNode_AnimVerlet, bPreserveLengthFromParent),
+		GET_MEMBER_NAME_CHECKED(FLKAnimNode_AnimVerlet, bPreserveLengthFromParentBetweenRealBones),
+		GET_MEMBER_NAME_CHECKED(FLKAnimNode_AnimVerlet, LengthFromParentMargin),
+		GET_MEMBER_NAME_CHECKED(FLKAnimNode_AnimVerlet, bPreserveSideLength),
+		GET_MEMBER_NAME_CHECKED(FLKAnimNode_AnimVerlet, bPreserveSideLengthBetweenRealBones),
+		GET_MEMBER_NAME_CHECKED(FLKAnimNode_AnimVerlet, SideLengthMargin),
+		GET_MEMBER_NAME_CHECKED(FLKAnimNode_AnimVerlet, bConstrainRightDiagonalDistance),
+		GET_MEMBER_NAME_CHECKED(FLKAnimNode_AnimVerlet, bConstrainLeftDiagonalDistance),
+		GET_MEMBER_NAME_CHECKED(FLKAnimNode_AnimVerlet, bStraightenBendedBone),
+		GET_MEMBER_NAME_CHECKED(FLKAnimNode_AnimVerlet, StraightenBendedBoneStrength),
+		GET_MEMBER_NAME_CHECKED(FLKAnimNode_AnimVerlet, bUseIsometricBendingConstraint),
+		GET_MEMBER_NAME_CHECKED(FLKAnimNode_AnimVerlet, BendingStiffness),
+		GET_MEMBER_NAME_CHECKED(FLKAnimNode_AnimVerlet, bUseBendingStiffnessRange),
+		GET_MEMBER_NAME_CHECKED(FLKAnimNode_AnimVerlet, BendingStiffnessMin),
+		GET_MEMBER_NAME_CHECKED(FLKAnimNode_AnimVerlet, BendingStiffnessMax),
+		GET_MEMBER_NAME_CHECKED(FLKAnimNode_AnimVerlet, BendingStiffnessMaxAngle),
+		GET_MEMBER_NAME_CHECKED(FLKAnimNode_AnimVerlet, InvBendingCompliance),
+		GET_MEMBER_NAME_CHECKED(FLKAnimNode_AnimVerlet, bUseBendingComplianceRange),
+		GET_MEMBER_NAME_CHECKED(FLKAnimNode_AnimVerlet, InvBendingComplianceMin),
+		GET_MEMBER_NAME_CHECKED(FLKAnimNode_AnimVerlet, InvBendingComplianceMax),
+		GET_MEMBER_NAME_CHECKED(FLKAnimNode_AnimVerlet, BendingComplianceMaxAngle),
+		GET_MEMBER_NAME_CHECKED(FLKAnimNode_AnimVerlet, bConstrainConeAngleFromParent),
+		GET_MEMBER_NAME_CHECKED(FLKAnimNode_AnimVerlet, ConeAngle),
+		GET_MEMBER_NAME_CHECKED(FLKAnimNode_AnimVerlet, ConeAngleOffset),
+		GET_MEMBER_NAME_CHECKED(FLKAnimNode_AnimVerlet, CustomDistanceConstraints),
+		GET_MEMBER_NAME_CHECKED(FLKAnimNode_AnimVerlet, SideStraightenForce),
+		GET_MEMBER_NAME_CHECKED(FLKAnimNode_AnimVerlet, Thickness),
+		GET_MEMBER_NAME_CHECKED(FLKAnimNode_AnimVerlet, bUseCapsuleCollisionForChain),
+	};
+
+	uint32 Hash = 0;
+	FString ExportedValue;
+	for (const FName& CurSettingName : TopologySettingNames)
+	{
+		const FProperty* CurProperty = FLKAnimNode_AnimVerlet::StaticStruct()->FindPropertyByName(CurSettingName);
+		verify(CurProperty != nullptr);
+		if (CurProperty == nullptr)
+			continue;
+
+		ExportedValue.Reset();
+		CurProperty->ExportTextItem_Direct(ExportedValue, CurProperty->ContainerPtrToValuePtr<void>(this), nullptr, nullptr, PPF_None);
+		Hash = FCrc::StrCrc32(*ExportedValue, Hash);
+	}
+
+	/// Flat bending settings are not properties(BETA), so their values are hashed directly
+	const bool FlatBendingFlags[] = { bUseFlatBendingConstraint, bUseFlatBendingComplianceRange, bUseFlatBendingStiffnessRange };
+	const float FlatBendingValues[] = { InvFlatBendingCompliance, InvFlatBendingComplianceMin, InvFlatBendingComplianceMax, FlatBendingComplianceMaxAngle,
+										FlatBendingStiffness, FlatBendingStiffnessMin, FlatBendingStiffnessMax, FlatBendingStiffnessMaxAngle, FlatBendingAlpha };
+	Hash = FCrc::MemCrc32(FlatBendingFlags, sizeof(FlatBendingFlags), Hash);
+	Hash = FCrc::MemCrc32(FlatBendingValues, sizeof(FlatBendingValues), Hash);
+	return Hash;
+}
+
+uint32 FLKAnimNode_AnimVerlet::CalculateTopologySkeletonHash(const FBoneContainer& BoneContainer)
+{
+	/// Bone names, hierarchy and reference pose of the mesh. Names are hashed as strings since name indices differ between runs.
+	const FReferenceSkeleton& ReferenceSkeleton = BoneContainer.GetReferenceSkeleton();
+	const TArray<FTransform>& RefBonePose = ReferenceSkeleton.GetRefBonePose();
+	uint32 Hash = GetTypeHash(ReferenceSkeleton.GetNum());
+	TCHAR BoneNameBuffer[NAME_SIZE];
+	for (int32 BoneIndex = 0; BoneIndex < ReferenceSkeleton.GetNum(); ++BoneIndex)
+	{
+		ReferenceSkeleton.GetBoneName(BoneIndex).ToString(BoneNameBuffer);
+		Hash = FCrc::StrCrc32(BoneNameBuffer, Hash);
+		Hash = HashCombine(Hash, GetTypeHash(ReferenceSkeleton.GetParentIndex(BoneIndex)));
+
+		const FVector RefLocation = RefBonePose[BoneIndex].GetTranslation();
+		const FQuat RefRotation = RefBonePose[BoneIndex].GetRotation();
+		const FVector RefScale = RefBonePose[BoneIndex].GetScale3D();
+		Hash = FCrc::MemCrc32(&RefLocation, sizeof(RefLocation), Hash);
+		Hash = FCrc::MemCrc32(&RefRotation, sizeof(RefRotation), Hash);
+		Hash = FCrc::MemCrc32(&RefScale, sizeof(RefScale), Hash);
+	}
+	return Hash;
+}
+
+#if WITH_EDITOR
+bool FLKAnimNode_AnimVerlet::BakeTopologyAsset(OUT ULKAnimVerletTopologyAsset& OutAsset, const FBoneContainer& BoneContainer) const
+{
+	if (BoneContainer.IsValid() == false)
+		return false;
+
+	/// The state LoadTopologyAsset expects: full chain resolution, no LOD override applied
+	FLKAnimNode_AnimVerlet Builder(*this);
+	Builder.ClearSimulateBones();
+	Builder.LODChainResolutionStride = 1;
+	Builder.InitializeBoneReferences(BoneContainer);
+
+	FLKAnimVerletSimulationTopology BuiltTopology;
+	{
+		FMemMark Mark(FMemStack::Get());
+		FCSPose<FCompactPose> ReferencePose;
+		ReferencePose.InitPose(&BoneContainer);
+		Builder.BuildSimulationTopology(ReferencePose, BoneContainer);
+		Builder.SwapSimulationTopology(BuiltTopology);
+	}
+	if (BuiltTopology.SimulateBones.Num() == 0)
+		return false;
+
+	OutAsset.SetTopology(IN OUT BuiltTopology, CalculateTopologySettingsHash(), CalculateTopologySkeletonHash(BoneContainer));
+	return true;
+}
+#endif
+
+uint32 FLKAnimNode_AnimVerlet::MakeShareKey(FComponentSpacePoseContext& PoseContext, int32 LODLevel, const UWorld* World) const
+{
+	const USkeletalMeshComponent* SkeletalMeshComponent = PoseContext.AnimInstanceProxy->GetSkelMeshComponent();
+	uint32 ShareKey = HashCombine(GetTypeHash(SkeletalMeshComponent->GetSkinnedAsset()), ShareSettingsHash);
+	ShareKey = HashCombine(ShareKey, GetTypeHash(ShareGroupName));
+	ShareKey = HashCombine(ShareKey, GetTypeHash(LODLevel));
+	if (ShareTimeBucket <= 0.0f)
+		return ShareKey;
+
+	/// The dominant asset player decides the animation
+	const FAnimTickRecord* DominantRecord = nullptr;
+	auto FindDominantRecord = [&DominantRecord](const TArray<FAnimTickRecord>& InRecords) {
+		for (const FAnimTickRecord& CurRecord : InRecords)
+		{
+			if (CurRecord.SourceAsset != nullptr && CurRecord.TimeAccumulator != nullptr && (DominantRecord == nullptr || CurRecord.EffectiveBlendWeight > DominantRecord->EffectiveBlendWeight))
+				DominantRecord = &CurRecord;
+		}
+	};
+	FindDominantRecord(PoseContext.AnimInstanceProxy->GetUngroupedActivePlayersRead());
+	for (const TPair<FName, FAnimGroupInstance>& CurSyncGroup : PoseContext.AnimInstanceProxy->GetSyncGroupMapRead())
+		FindDominantRecord(CurSyncGroup.Value.ActivePlayers);
+	if (DominantRecord == nullptr)
+		return ShareKey;
+
+	/// The phase relative to the world time stays constant while the animation plays, so instances do not keep moving between groups
+	const float PlayLength = DominantRecord->SourceAsset->GetPlayLength();
+	float Phase = *DominantRecord->TimeAccumulator - (World != nullptr ? World->GetTimeSeconds() : 0.0f);
+	if (PlayLength > UE_SMALL_NUMBER)
+	{
+		Phase = FMath::Fmod(Phase, PlayLength);
+		if (Phase < 0.0f)
+			Phase += PlayLength;
+	}
+	ShareKey = HashCombine(ShareKey, GetTypeHash(DominantRecord->SourceAsset));
+	ShareKey = HashCombine(ShareKey, GetTypeHash(FMath::FloorToInt(Phase / ShareTimeBucket)));
+	return ShareKey;
+}
+
+void FLKAnimNode_AnimVerlet::PublishSharedResult(const TArray<FBoneTransform>& InBoneTransforms, FComponentSpacePoseContext& PoseContext)
+{
+	SharedResult.Reset(InBoneTransforms.Num());
+	for (const FBoneTransform& CurBoneTransform : InBoneTransforms)
+	{
+		FLKAnimVerletCachedBoneResult& CurResult = SharedResult.Emplace_GetRef();
+		CurResult.BonePoseIndex = CurBoneTransform.BoneIndex;
+		CurResult.PoseT = PoseContext.Pose.GetComponentSpaceTransform(CurBoneTransform.BoneIndex);
+		CurResult.PoseOffset = CurBoneTransform.Transform.GetRelativeTransform(CurResult.PoseT);
+	}
+	LKAnimVerletShareRegistry::Get().PublishResult(ShareHandle, SharedResult);
+}
+
+bool FLKAnimNode_AnimVerlet::ApplySharedResult(OUT TArray<FBoneTransform>& OutBoneTransforms, FComponentSpacePoseContext& PoseContext, const FBoneContainer& BoneContainer)
+{
+	const int32 MaxPhaseOffsetFrames = FMath::Clamp(SharePhaseOffsetFrames, 0, LKAnimVerletShareRegistry::MaxPhaseOffsetFrames);
+	const int32 PhaseOffsetFrames = bRandomizeSharePhaseOffset ? FRandomStream(ShareHandle).RandRange(0, MaxPhaseOffsetFrames) : MaxPhaseOffsetFrames;
+	if (LKAnimVerletShareRegistry::Get().CopyResult(ShareHandle, PhaseOffsetFrames, OUT SharedResult) == false)
+		return false;
+
+	/// Same mesh and LOD, so the compact pose indexes match. Guard against a required bones change on this instance.
+	const int32 NumPoseBones = BoneContainer.GetCompactPoseNumBones();
+	OutBoneTransforms.Reserve(OutBoneTransforms.Num() + SharedResult.Num());
+	for (const FLKAnimVerletCachedBoneResult& CurResult : SharedResult)
+	{
+		if (CurResult.BonePoseIndex.GetInt() >= NumPoseBones)
+			continue;
+
+		const FTransform& CurPoseT = PoseContext.Pose.GetComponentSpaceTransform(CurResult.BonePoseIndex);
+		OutBoneTransforms.Emplace(FBoneTransform(CurResult.BonePoseIndex, CurResult.PoseOffset * CurPoseT));
+	}
+
+	INC_DWORD_STAT(STAT_AnimVerlet_Share_FollowerNodes);
+	return true;
+}
+
 void FLKAnimNode_AnimVerlet::ResetOutputBlend()
 {
 	OutputBlendAlpha = 0.0f;
+	OutputBlendSourceOffsets.Reset();
+}
+
+void FLKAnimNode_AnimVerlet::BeginOutputBlendFromCurrentResult()
+{
+	/// Capture what was visible on the last frame relative to its pose, including a blend still in progress
+	TArray<FTransform> NewSourceOffsets;
+	NewSourceOffsets.SetNum(RelevantBoneIndicators.Num());
+	for (int32 i = 0; i < RelevantBoneIndicators.Num(); ++i)
+	{
+		const FLKAnimVerletBoneIndicator& CurBoneIndicator = RelevantBoneIndicators[i];
+		const FLKAnimVerletBoneBase* CurBone = nullptr;
+		if (CurBoneIndicator.bExcludedBone == false)
+			CurBone = &SimulateBones[CurBoneIndicator.AnimVerletBoneIndex];
+		else
+			CurBone = &ExcludedBones[CurBoneIndicator.AnimVerletBoneIndex];
+
+		const FTransform ResultOffset = FTransform(CurBone->Rotation, CurBone->Location).GetRelativeTransform(FTransform(CurBone->PoseRotation, CurBone->PoseLocation));
+		const FTransform SourceOffset = OutputBlendSourceOffsets.IsValidIndex(i) ? OutputBlendSourceOffsets[i] : FTransform::Identity;
+		NewSourceOffsets[i].Blend(SourceOffset, ResultOffset, FMath::Clamp(OutputBlendAlpha, 0.0f, 1.0f));
+	}
+
+	OutputBlendSourceOffsets = MoveTemp(NewSourceOffsets);
+	OutputBlendAlpha = 0.0f;
 }
 
 void FLKAnimNode_AnimVerlet::AdvanceOutputBlend(float InDeltaTime)
@@ -2518,13 +4326,24 @@ void FLKAnimNode_AnimVerlet::AdvanceOutputBlend(float InDeltaTime)
 	if (OutputBlendDuration <= UE_SMALL_NUMBER)
 	{
 		OutputBlendAlpha = 1.0f;
+		OutputBlendSourceOffsets.Reset();
 		return;
 	}
 
 	OutputBlendAlpha = FMath::Clamp(OutputBlendAlpha + FMath::Max(InDeltaTime, 0.0f) / OutputBlendDuration, 0.0f, 1.0f);
+	if (OutputBlendAlpha >= 1.0f)
+		OutputBlendSourceOffsets.Reset();
 }
 
 void FLKAnimNode_AnimVerlet::ClearSimulateBones()
+{
+	CancelAsyncTopologyBuild();
+	LODTopologyCache.Reset();
+	ActiveLODTopologyKey = 0;
+	ClearSimulationTopology();
+}
+
+void FLKAnimNode_AnimVerlet::ClearSimulationTopology()
 {
 	SimulatingCollisionShapes.ResetCollisionShapeList();
 
@@ -2552,13 +4371,42 @@ void FLKAnimNode_AnimVerlet::ClearSimulateBones()
 	SimulateBonePairIndicators.Reset();
 	SimulateBoneTriangleIndicators.Reset();
 	ExcludedBones.Reset();
+	WorldCollisionExcludeBoneBits.Reset();
+	SleepIslands.Reset();
+	SimulateBoneIslandIndexes.Reset();
 	SimulateBones.Reset();
+	ResetTopologyTransientState();
+}
+
+void FLKAnimNode_AnimVerlet::ResetTopologyTransientState()
+{
+	WorldGroundPlane = FLKAnimVerletWorldContactPlane();
+	CachedWindVelocities.Reset();
+	NumSleepingIslands = 0;
+	SleepingBoneFraction = 0.0f;
+	PrevColliderBounds.Reset();
+	SleepingResultCache.Reset();
+	SleepingResultColliderPoses.Reset();
+	bHasSleepingResultCache = false;
+	SwayStates.Reset();
+	bProceduralSwayStateValid = false;
+	OutputBlendSourceOffsets.Reset();
 }
 
 void FLKAnimNode_AnimVerlet::ResetSimulation()
 {
 	FixedStepAccumulator = 0.0f;
 	NumPendingSimulationSteps = 0;
+	RandomWindNoiseTime = 0.0f;
+	PrevInertialMoveDiff = FVector::ZeroVector;
+	PrevInertialRotVector = FVector::ZeroVector;
+	bHasPrevInertialDiff = false;
+	for (FLKAnimVerletSleepIsland& CurIsland : SleepIslands)
+		CurIsland.bSleep = false;
+	NumSleepingIslands = 0;
+	SleepingBoneFraction = 0.0f;
+	bHasSleepingResultCache = false;
+	bProceduralSwayStateValid = false;
 
 	for (int32 i = 0; i < SimulateBones.Num(); ++i)
 	{
@@ -2729,6 +4577,9 @@ void FLKAnimNode_AnimVerlet::SyncFromOtherAnimVerletNode(const FLKAnimNode_AnimV
 	bSubDivideBones = Other.bSubDivideBones;
 	NumSubDividedBone = Other.NumSubDividedBone;
 	bRebuildSimulationOnLODChange = Other.bRebuildSimulationOnLODChange;
+	bCacheSimulationPerLOD = Other.bCacheSimulationPerLOD;
+	InitializationMode = Other.InitializationMode;
+	TopologyAsset = Other.TopologyAsset;
 	bActivate = Other.bActivate;
 	bSkipUpdateOnDedicatedServer = Other.bSkipUpdateOnDedicatedServer;
 	bPause = Other.bPause;
@@ -2833,6 +4684,21 @@ void FLKAnimNode_AnimVerlet::SyncFromOtherAnimVerletNode(const FLKAnimNode_AnimV
 
 	WorldCollisionProfile = Other.WorldCollisionProfile;
 	WorldCollisionExcludeBones = Other.WorldCollisionExcludeBones;
+	bUseAsyncWorldCollision = Other.bUseAsyncWorldCollision;
+	bUseWorldGeometryCache = Other.bUseWorldGeometryCache;
+	WorldGeometryCacheMargin = Other.WorldGeometryCacheMargin;
+	bUseWorldCollisionContactCache = Other.bUseWorldCollisionContactCache;
+	WorldCollisionContactCacheDistance = Other.WorldCollisionContactCacheDistance;
+	WorldCollisionContactCacheMotionThreshold = Other.WorldCollisionContactCacheMotionThreshold;
+	bUseWorldCollisionEarlyOut = Other.bUseWorldCollisionEarlyOut;
+	WorldCollisionEarlyOutMargin = Other.WorldCollisionEarlyOutMargin;
+	bUseWorldGroundPlane = Other.bUseWorldGroundPlane;
+	WorldGroundPlaneTraceStartHeight = Other.WorldGroundPlaneTraceStartHeight;
+	WorldGroundPlaneTraceDepth = Other.WorldGroundPlaneTraceDepth;
+	WorldGroundPlaneUpdateDistance = Other.WorldGroundPlaneUpdateDistance;
+	WorldGroundPlaneUpdateAngle = Other.WorldGroundPlaneUpdateAngle;
+	bSkipWorldCollisionForStationaryBones = Other.bSkipWorldCollisionForStationaryBones;
+	WorldCollisionStationaryThreshold = Other.WorldCollisionStationaryThreshold;
 
 	SphereCollisionShapes = Other.SphereCollisionShapes;
 	CapsuleCollisionShapes = Other.CapsuleCollisionShapes;
@@ -2859,9 +4725,13 @@ void FLKAnimNode_AnimVerlet::SyncFromOtherAnimVerletNode(const FLKAnimNode_AnimV
 	RandomWindSizeMax = Other.RandomWindSizeMax;
 	bRandomWindDirectionInWorldSpace = Other.bRandomWindDirectionInWorldSpace;
 	AdditionalRandomWinds = Other.AdditionalRandomWinds;
+	RandomWindNoiseFrequency = Other.RandomWindNoiseFrequency;
+	RandomWindNoiseSpeed = Other.RandomWindNoiseSpeed;
+	RandomWindSeed = Other.RandomWindSeed;
 
 	bAdjustWindComponent = Other.bAdjustWindComponent;
 	WindComponentScale = Other.WindComponentScale;
+	WindComponentSampleCount = Other.WindComponentSampleCount;
 
 	MoveInertiaScale = Other.MoveInertiaScale;
 	bIgnoreSuddenMoveInertia = Other.bIgnoreSuddenMoveInertia;
@@ -2875,6 +4745,28 @@ void FLKAnimNode_AnimVerlet::SyncFromOtherAnimVerletNode(const FLKAnimNode_AnimV
 	bClampRotationInertia = Other.bClampRotationInertia;
 	RotationInertiaClampDegrees = Other.RotationInertiaClampDegrees;
 	ComponentInertiaTangentialDamping = Other.ComponentInertiaTangentialDamping;
+	bSimulateInInertialFrame = Other.bSimulateInInertialFrame;
+	bUseIslandSleep = Other.bUseIslandSleep;
+	SleepIslandColliderWakeMargin = Other.SleepIslandColliderWakeMargin;
+	bUseSleepingResultCache = Other.bUseSleepingResultCache;
+	bUseSignificanceLOD = Other.bUseSignificanceLOD;
+	SignificanceOverride = Other.SignificanceOverride;
+	SignificanceFullScreenSize = Other.SignificanceFullScreenSize;
+	SignificanceTiers = Other.SignificanceTiers;
+	LODFeatureOverrides = Other.LODFeatureOverrides;
+	bUseBudgetScheduler = Other.bUseBudgetScheduler;
+	BudgetPriority = Other.BudgetPriority;
+	OffscreenMode = Other.OffscreenMode;
+	OffscreenTime = Other.OffscreenTime;
+	OffscreenUpdateInterval = Other.OffscreenUpdateInterval;
+	bResetWhenBecomeVisible = Other.bResetWhenBecomeVisible;
+	OffscreenMaxCatchUpTime = Other.OffscreenMaxCatchUpTime;
+	bShareSimulationResult = Other.bShareSimulationResult;
+	ShareGroupName = Other.ShareGroupName;
+	ShareTimeBucket = Other.ShareTimeBucket;
+	SharePhaseOffsetFrames = Other.SharePhaseOffsetFrames;
+	bRandomizeSharePhaseOffset = Other.bRandomizeSharePhaseOffset;
+	SleepingResultCacheRotationTolerance = Other.SleepingResultCacheRotationTolerance;
 }
 
 void FLKAnimNode_AnimVerlet::ApplyPresetType(ELKAnimVerletPreset InPresetType)
@@ -2964,7 +4856,7 @@ void FLKAnimNode_AnimVerlet::DebugDrawAnimVerlet(const FComponentSpacePoseContex
 	}
 
 #if (ENGINE_MINOR_VERSION >= 4)
-	const bool bDrawTriangle = bUseCapsuleCollisionForChain && (IsSingleChain() == false);
+	const bool bDrawTriangle = ShouldUseCapsuleCollisionForChain() && (IsSingleChain() == false);
 	if (bDrawTriangle)
 	{
 		for (const FLKAnimVerletBoneIndicatorTriangle& CurTriangle : SimulateBoneTriangleIndicators)
@@ -10,6 +10,7 @@
 #include <PhysicsEngine/SkeletalBodySetup.h>
 #include <PhysicsEngine/SphereElem.h>
 #include <PhysicsEngine/SphylElem.h>
+#include "LKAnimVerletBodySetupUtil.h"
 #include "LKAnimVerletCollisionData.h"
 
 namespace LkAnimVerlet
@@ -0,0 +1,12 @@
+#pragma once
+#include <CoreMinimal.h>
+
+struct FBodyInstance;
+struct FLKAnimVerletCollisionShapeList;
+class UBodySetup;
+
+namespace LkAnimVerlet
+{
+	FTransform GetBodyWorldTransform(const FBodyInstance* BodyInstance, const FTransform& FallbackWorldTransform);
+	void AddBodySetupShapes(FLKAnimVerletCollisionShapeList& OutShapeList, const UBodySetup& BodySetup, const FVector& BodyScale, const FTransform& BodyWorldTransform);
+}
@@ -1,5 +1,6 @@
 #include "LKAnimVerletBone.h"
 
+#include "LKAnimVerletConstraintUtil.h"
 #include "LKAnimVerletSetting.h"
 
 ///=========================================================================================================================================
@@ -72,7 +73,7 @@ void FLKAnimVerletBone::PrepareSimulation(const FTransform& PoseT, const FVector
 	PoseScale = PoseT.GetScale3D();
 }
 
-void FLKAnimVerletBone::Update(float DeltaTime, const FLKAnimVerletUpdateParam& InParam)
+void FLKAnimVerletBone::Update(float DeltaTime, const FLKAnimVerletUpdateParam& InParam, bool bApplyComponentFrameMotion)
 {
 	const float CurDeltaTime = InParam.bUseSquaredDeltaTime ? DeltaTime * DeltaTime : DeltaTime;
 	const float ForceMassScale = InvMass;
@@ -81,7 +82,8 @@ void FLKAnimVerletBone::Update(float DeltaTime, const FLKAnimVerletUpdateParam&
 	Location += MoveDelta * InParam.Damping;
 
 	/// Rebase the complete Verlet state from the previous component frame into the current component frame.
-	if (InParam.ComponentMoveDiff.IsNearlyZero(KINDA_SMALL_NUMBER) == false || InParam.ComponentRotDiff.Equals(FQuat::Identity, KINDA_SMALL_NUMBER) == false)
+	/// Skipped for a sleeping bone that rides along with the component frame.
+	if (bApplyComponentFrameMotion && (InParam.ComponentMoveDiff.IsNearlyZero(KINDA_SMALL_NUMBER) == false || InParam.ComponentRotDiff.Equals(FQuat::Identity, KINDA_SMALL_NUMBER) == false))
 	{
 		Location = InParam.ComponentRotDiff.RotateVector(Location) + InParam.ComponentMoveDiff;
 		PrevLocation = InParam.ComponentRotDiff.RotateVector(PrevLocation) + InParam.ComponentMoveDiff;
@@ -89,6 +91,10 @@ void FLKAnimVerletBone::Update(float DeltaTime, const FLKAnimVerletUpdateParam&
 		PrevRotation = (InParam.ComponentRotDiff * PrevRotation).GetNormalized();
 	}
 
+	/// Inertial frame: only the component acceleration displaces the bone, the Verlet history is left as is
+	if (bApplyComponentFrameMotion && InParam.bApplyInertialDisplacement)
+		Location += InParam.MakeInertialDisplacement(Location);
+
 	/// Gravity
 	Location += InParam.Gravity * CurDeltaTime;
 
@@ -102,15 +108,23 @@ void FLKAnimVerletBone::Update(float DeltaTime, const FLKAnimVerletUpdateParam&
 	/// ExternalForce
 	Location += InParam.ExternalForce * (CurDeltaTime * ForceMassScale);
 
-	/// RandomWind
+	/// RandomWind(coherent noise over pose location and simulated time, each wind uses its own seed)
 	{
+		const FVector NoiseLocation = PoseLocation * InParam.RandomWindNoiseFrequency + InParam.RandomWindNoiseOffset;
 		if (InParam.RandomWind.RandomForceDirection.IsNearlyZero(KINDA_SMALL_NUMBER) == false)
-			Location += InParam.RandomWind.RandomForceDirection * FMath::RandRange(InParam.RandomWind.RandomForceSizeMin, InParam.RandomWind.RandomForceSizeMax) * (CurDeltaTime * ForceMassScale);
+		{
+			const float NoiseAlpha = LKAnimVerletUtil::ValueNoise3D(NoiseLocation, InParam.RandomWindSeed);
+			Location += InParam.RandomWind.RandomForceDirection * FMath::Lerp(InParam.RandomWind.RandomForceSizeMin, InParam.RandomWind.RandomForceSizeMax, NoiseAlpha) * (CurDeltaTime * ForceMassScale);
+		}
 
-		for (const FLKAnimVerletRandomForceSetting& CurWind : InParam.AdditionalRandomWinds)
+		for (int32 i = 0; i < InParam.AdditionalRandomWinds.Num(); ++i)
 		{
+			const FLKAnimVerletRandomForceSetting& CurWind = InParam.AdditionalRandomWinds[i];
 			if (CurWind.RandomForceDirection.IsNearlyZero(KINDA_SMALL_NUMBER) == false)
-				Location += CurWind.RandomForceDirection * FMath::RandRange(CurWind.RandomForceSizeMin, CurWind.RandomForceSizeMax) * (CurDeltaTime * ForceMassScale);
+			{
+				const float NoiseAlpha = LKAnimVerletUtil::ValueNoise3D(NoiseLocation, InParam.RandomWindSeed + static_cast<uint32>(i + 1));
+				Location += CurWind.RandomForceDirection * FMath::Lerp(CurWind.RandomForceSizeMin, CurWind.RandomForceSizeMax, NoiseAlpha) * (CurDeltaTime * ForceMassScale);
+			}
 		}
 	}
 
@@ -108,6 +108,9 @@ void LKAnimVerletBroadphaseContainer::Update()
 			const FLKAnimVerletBoneIndicatorTriangle& CurTriangle = (*BoneTrianglesNullable)[i];
 			if (CurTriangle.BoneA.IsValidBoneIndicator() == false || CurTriangle.BoneB.IsValidBoneIndicator() == false || CurTriangle.BoneC.IsValidBoneIndicator() == false)
 				continue;
+			/// Sleeping bones are held in place, so their fat bound is still valid
+			if ((*SimulatingBones)[CurTriangle.BoneA.AnimVerletBoneIndex].IsSleep() && (*SimulatingBones)[CurTriangle.BoneB.AnimVerletBoneIndex].IsSleep() && (*SimulatingBones)[CurTriangle.BoneC.AnimVerletBoneIndex].IsSleep())
+				continue;
 
 			const FVector MoveDeltaA = (*SimulatingBones)[CurTriangle.BoneA.AnimVerletBoneIndex].MoveDelta;
 			const FVector MoveDeltaB = (*SimulatingBones)[CurTriangle.BoneB.AnimVerletBoneIndex].MoveDelta;
@@ -128,6 +131,8 @@ void LKAnimVerletBroadphaseContainer::Update()
 			const FLKAnimVerletBoneIndicatorPair& CurPair = (*BonePairsNullable)[i];
 			if (CurPair.BoneA.IsValidBoneIndicator() == false || CurPair.BoneB.IsValidBoneIndicator() == false)
 				continue;
+			if ((*SimulatingBones)[CurPair.BoneA.AnimVerletBoneIndex].IsSleep() && (*SimulatingBones)[CurPair.BoneB.AnimVerletBoneIndex].IsSleep())
+				continue;
 
 			const FVector MoveDeltaA = (*SimulatingBones)[CurPair.BoneA.AnimVerletBoneIndex].MoveDelta;
 			const FVector MoveDeltaB = (*SimulatingBones)[CurPair.BoneB.AnimVerletBoneIndex].MoveDelta;
@@ -145,6 +150,9 @@ void LKAnimVerletBroadphaseContainer::Update()
 			const LKAnimVerletBVH<FLKAnimVerletBpData>::LKBvhID CurBroadphaseID = BroadphaseIdList[i];
 
 			const FLKAnimVerletBone& CurBone = (*SimulatingBones)[i];
+			if (CurBone.IsSleep())
+				continue;
+
 			const FVector MoveDelta = CurBone.MoveDelta;
 
 			const FLKAnimVerletBound CurBound = CurBone.MakeBound();
@@ -0,0 +1,167 @@
+#include "LKAnimVerletBudgetScheduler.h"
+
+#include <HAL/IConsoleManager.h>
+#include <Misc/ScopeLock.h>
+#include <ProfilingDebugging/CpuProfilerTrace.h>
+#include <ProfilingDebugging/MiscTrace.h>
+
+static TAutoConsoleVariable<float> CVarAnimNodeAnimVerletBudgetMs(TEXT("a.AnimNode.AnimVerlet.BudgetMs"), 0.0f, TEXT("Total AnimVerlet simulation budget per frame in milliseconds. 0 disables the budget scheduler"));
+static TAutoConsoleVariable<int32> CVarAnimNodeAnimVerletMaxInitializationsPerFrame(TEXT("a.AnimNode.AnimVerlet.MaxInitializationsPerFrame"), 2, TEXT("Number of TimeSliced AnimVerlet nodes allowed to build their simulation per frame. 0 is unlimited"));
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("AnimVerlet_Budget_TimeSlicedNodes"), STAT_AnimVerlet_Budget_TimeSlicedNodes, STATGROUP_Anim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AnimVerlet_Budget_ReducedIterationNodes"), STAT_AnimVerlet_Budget_ReducedIterationNodes, STATGROUP_Anim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AnimVerlet_Budget_FrozenNodes"), STAT_AnimVerlet_Budget_FrozenNodes, STATGROUP_Anim);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("AnimVerlet_Budget_EstimatedCostMs"), STAT_AnimVerlet_Budget_EstimatedCostMs, STATGROUP_Anim);
+
+/// Entries not updated for this many frames belong to destroyed or inactive nodes
+static constexpr uint64 LKG_BUDGET_STALE_FRAMES = 4;
+
+LKAnimVerletBudgetScheduler& LKAnimVerletBudgetScheduler::Get()
+{
+	static LKAnimVerletBudgetScheduler Scheduler;
+	return Scheduler;
+}
+
+bool LKAnimVerletBudgetScheduler::IsEnabled()
+{
+	return CVarAnimNodeAnimVerletBudgetMs.GetValueOnAnyThread() > 0.0f;
+}
+
+const TCHAR* LKAnimVerletBudgetScheduler::GetDecisionName(ELKAnimVerletBudgetDecision InDecision)
+{
+	switch (InDecision)
+	{
+		case ELKAnimVerletBudgetDecision::TimeSliced:		return TEXT("AnimVerlet_Budget_TimeSliced");
+		case ELKAnimVerletBudgetDecision::ReducedIteration:	return TEXT("AnimVerlet_Budget_ReducedIteration");
+		case ELKAnimVerletBudgetDecision::Frozen:			return TEXT("AnimVerlet_Budget_Frozen");
+		default:											return TEXT("AnimVerlet_Budget_Full");
+	}
+}
+
+ELKAnimVerletBudgetDecision LKAnimVerletBudgetScheduler::UpdateEntry(IN OUT int32& InOutHandle, float InPriority)
+{
+	const float BudgetMs = CVarAnimNodeAnimVerletBudgetMs.GetValueOnGameThread();
+	if (BudgetMs <= 0.0f)
+		return ELKAnimVerletBudgetDecision::Full;
+
+	FScopeLock ScopeLock(&EntriesLock);
+
+	/// The first node of a frame rebalances with the costs reported during the previous frame
+	if (LastRebalanceFrame != GFrameCounter)
+	{
+		LastRebalanceFrame = GFrameCounter;
+		Rebalance(BudgetMs);
+	}
+
+	if (InOutHandle == INDEX_NONE || Entries.Contains(InOutHandle) == false)
+	{
+		InOutHandle = NextHandle++;
+		Entries.Emplace(InOutHandle);
+	}
+
+	FLKBudgetEntry& Entry = Entries.FindChecked(InOutHandle);
+	Entry.Priority = FMath::Max(InPriority, 0.0f);
+	Entry.LastUpdateFrame = GFrameCounter;
+	return Entry.Decision;
+}
+
+void LKAnimVerletBudgetScheduler::ReportCost(int32 InHandle, float InCostMs, ELKAnimVerletBudgetDecision InDecision)
+{
+	FScopeLock ScopeLock(&EntriesLock);
+
+	FLKBudgetEntry* FoundEntry = Entries.Find(InHandle);
+	if (FoundEntry == nullptr)
+		return;
+
+	/// Reduced iterations measure a cheaper solve. Keep the full cost estimate unless there is none yet.
+	if (InDecision == ELKAnimVerletBudgetDecision::ReducedIteration && FoundEntry->FullCostMs > 0.0f)
+		return;
+
+	/// Smooth out spikes(LOD rebuild, collision bursts) so decisions do not flip every frame
+	FoundEntry->FullCostMs = (FoundEntry->FullCostMs > 0.0f) ? FMath::Lerp(FoundEntry->FullCostMs, InCostMs, 0.2f) : InCostMs;
+}
+
+bool LKAnimVerletBudgetScheduler::TryAcquireInitialization()
+{
+	const int32 MaxInitializations = CVarAnimNodeAnimVerletMaxInitializationsPerFrame.GetValueOnAnyThread();
+	if (MaxInitializations <= 0)
+		return true;
+
+	FScopeLock ScopeLock(&InitializationLock);
+	if (LastInitializationFrame != GFrameCounter)
+	{
+		LastInitializationFrame = GFrameCounter;
+		NumInitializationsThisFrame = 0;
+	}
+
+	if (NumInitializationsThisFrame >= MaxInitializations)
+		return false;
+
+	++NumInitializationsThisFrame;
+	return true;
+}
+
+void LKAnimVerletBudgetScheduler::Rebalance(float BudgetMs)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(AnimVerlet_Budget_Rebalance);
+
+	for (auto EntryIt = Entries.CreateIterator(); EntryIt; ++EntryIt)
+	{
+		if (EntryIt.Value().LastUpdateFrame + LKG_BUDGET_STALE_FRAMES < GFrameCounter)
+			EntryIt.RemoveCurrent();
+	}
+
+	TArray<FLKBudgetEntry*, TInlineAllocator<64>> SortedEntries;
+	SortedEntries.Reserve(Entries.Num());
+	float EstimatedCostMs = 0.0f;
+	for (TPair<int32, FLKBudgetEntry>& CurPair : Entries)
+	{
+		CurPair.Value.Decision = ELKAnimVerletBudgetDecision::Full;
+		EstimatedCostMs += CurPair.Value.FullCostMs;
+		SortedEntries.Emplace(&CurPair.Value);
+	}
+	SortedEntries.Sort([](const FLKBudgetEntry& A, const FLKBudgetEntry& B) { return A.Priority < B.Priority; });
+
+	/// Demote every lowest priority node by one level before any node goes to the next level
+	const ELKAnimVerletBudgetDecision EscalationLevels[] = { ELKAnimVerletBudgetDecision::TimeSliced, ELKAnimVerletBudgetDecision::ReducedIteration, ELKAnimVerletBudgetDecision::Frozen };
+	int32 NumDemoted[UE_ARRAY_COUNT(EscalationLevels)] = { 0, };
+	for (int32 LevelIndex = 0; LevelIndex < UE_ARRAY_COUNT(EscalationLevels) && EstimatedCostMs > BudgetMs; ++LevelIndex)
+	{
+		for (int32 i = 0; i < SortedEntries.Num() && EstimatedCostMs > BudgetMs; ++i)
+		{
+			FLKBudgetEntry& CurEntry = *SortedEntries[i];
+			EstimatedCostMs -= EstimateFrameCost(CurEntry, CurEntry.Decision);
+			CurEntry.Decision = EscalationLevels[LevelIndex];
+			EstimatedCostMs += EstimateFrameCost(CurEntry, CurEntry.Decision);
+			++NumDemoted[LevelIndex];
+		}
+	}
+
+	/// Counts per final level. A node demoted to a higher level is not counted in the lower one.
+	const int32 NumFrozen = NumDemoted[2];
+	const int32 NumReducedIteration = NumDemoted[1] - NumFrozen;
+	const int32 NumTimeSliced = NumDemoted[0] - NumDemoted[1];
+	SET_DWORD_STAT(STAT_AnimVerlet_Budget_TimeSlicedNodes, NumTimeSliced);
+	SET_DWORD_STAT(STAT_AnimVerlet_Budget_ReducedIterationNodes, NumReducedIteration);
+	SET_DWORD_STAT(STAT_AnimVerlet_Budget_FrozenNodes, NumFrozen);
+	SET_FLOAT_STAT(STAT_AnimVerlet_Budget_EstimatedCostMs, EstimatedCostMs);
+
+	/// Bookmark only when the decisions change to keep the timeline readable
+	static_assert(UE_ARRAY_COUNT(EscalationLevels) == UE_ARRAY_COUNT(PrevNumDemoted), "One demotion count per escalation level");
+	if (FMemory::Memcmp(PrevNumDemoted, NumDemoted, sizeof(NumDemoted)) != 0)
+	{
+		TRACE_BOOKMARK(TEXT("AnimVerlet Budget %.2fms/%.2fms: TimeSliced %d, ReducedIteration %d, Frozen %d"), EstimatedCostMs, BudgetMs, NumTimeSliced, NumReducedIteration, NumFrozen);
+		FMemory::Memcpy(PrevNumDemoted, NumDemoted, sizeof(NumDemoted));
+	}
+}
+
+float LKAnimVerletBudgetScheduler::EstimateFrameCost(const FLKBudgetEntry& InEntry, ELKAnimVerletBudgetDecision InDecision)
+{
+	switch (InDecision)
+	{
+		case ELKAnimVerletBudgetDecision::TimeSliced:		return InEntry.FullCostMs / TimeSliceInterval;
+		case ELKAnimVerletBudgetDecision::ReducedIteration:	return InEntry.FullCostMs * 0.5f / TimeSliceInterval;
+		case ELKAnimVerletBudgetDecision::Frozen:			return 0.0f;
+		default:											return InEntry.FullCostMs;
+	}
+}
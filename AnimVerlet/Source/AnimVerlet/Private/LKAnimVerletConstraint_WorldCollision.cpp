@@ -1,15 +1,43 @@
 #include "LKAnimVerletConstraint_Collision.h"
 
+#include <Components/PrimitiveComponent.h>
+#include <Engine/OverlapResult.h>
+#include <Engine/World.h>
+#include <PhysicsEngine/AggregateGeom.h>
+#include <PhysicsEngine/BodyInstance.h>
+#include <PhysicsEngine/BodySetup.h>
+#include <PhysicsEngine/ConvexElem.h>
+#include "LKAnimVerletBodySetupUtil.h"
 #include "LKAnimVerletBone.h"
 #include "LKAnimVerletBroadphaseContainer.h"
 #include "LKAnimVerletCollisionRigidUtil.h"
+#include "LKAnimVerletCollisionShape.h"
 #include "LKAnimVerletConstraintUtil.h"
 
+DECLARE_CYCLE_STAT(TEXT("AnimVerlet_WorldCollision_IssueAsyncQueries"), STAT_AnimVerlet_WorldCollision_IssueAsyncQueries, STATGROUP_Anim);
+DECLARE_CYCLE_STAT(TEXT("AnimVerlet_WorldCollision_ConsumeAsyncQueries"), STAT_AnimVerlet_WorldCollision_ConsumeAsyncQueries, STATGROUP_Anim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AnimVerlet_WorldCollision_SyncQueries"), STAT_AnimVerlet_WorldCollision_SyncQueries, STATGROUP_Anim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AnimVerlet_WorldCollision_AsyncQueries"), STAT_AnimVerlet_WorldCollision_AsyncQueries, STATGROUP_Anim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AnimVerlet_WorldCollision_AsyncQueriesNotReady"), STAT_AnimVerlet_WorldCollision_AsyncQueriesNotReady, STATGROUP_Anim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AnimVerlet_WorldCollision_AsyncLatencyFrames"), STAT_AnimVerlet_WorldCollision_AsyncLatencyFrames, STATGROUP_Anim);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("AnimVerlet_WorldCollision_AsyncLatencyMs"), STAT_AnimVerlet_WorldCollision_AsyncLatencyMs, STATGROUP_Anim);
+DECLARE_CYCLE_STAT(TEXT("AnimVerlet_WorldCollision_UpdateGeometryCache"), STAT_AnimVerlet_WorldCollision_UpdateGeometryCache, STATGROUP_Anim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AnimVerlet_WorldCollision_GeometryCacheQueries"), STAT_AnimVerlet_WorldCollision_GeometryCacheQueries, STATGROUP_Anim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AnimVerlet_WorldCollision_GeometryCacheShapes"), STAT_AnimVerlet_WorldCollision_GeometryCacheShapes, STATGROUP_Anim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AnimVerlet_WorldCollision_ContactCacheHits"), STAT_AnimVerlet_WorldCollision_ContactCacheHits, STATGROUP_Anim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AnimVerlet_WorldCollision_ContactCacheLookups"), STAT_AnimVerlet_WorldCollision_ContactCacheLookups, STATGROUP_Anim);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("AnimVerlet_WorldCollision_ContactCacheHitRate"), STAT_AnimVerlet_WorldCollision_ContactCacheHitRate, STATGROUP_Anim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AnimVerlet_WorldCollision_ChainEarlyOutQueries"), STAT_AnimVerlet_WorldCollision_ChainEarlyOutQueries, STATGROUP_Anim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AnimVerlet_WorldCollision_ChainEarlyOutSkips"), STAT_AnimVerlet_WorldCollision_ChainEarlyOutSkips, STATGROUP_Anim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AnimVerlet_WorldCollision_StationarySkippedSweeps"), STAT_AnimVerlet_WorldCollision_StationarySkippedSweeps, STATGROUP_Anim);
+
 
 ///=========================================================================================================================================
 /// FLKAnimVerletConstraint_World
 ///=========================================================================================================================================
-FLKAnimVerletConstraint_World::FLKAnimVerletConstraint_World(const UWorld* InWorld, UPrimitiveComponent* InSelfComponent, const FName& InCollisionProfileName, const FLKAnimVerletCollisionConstraintInput& InCollisionInput)
+FLKAnimVerletConstraint_World::FLKAnimVerletConstraint_World(const UWorld* InWorld, UPrimitiveComponent* InSelfComponent, const FName& InCollisionProfileName, 
+															 const FLKAnimVerletCollisionConstraintInput& InCollisionInput, 
+															 const FLKAnimVerletWorldCollisionConstraintInput& InWorldCollisionInput)
 	: WorldPtr(InWorld)
 	, SelfComponentPtr(InSelfComponent)
 	, WorldCollisionProfileName(InCollisionProfileName)
@@ -18,6 +46,16 @@ FLKAnimVerletConstraint_World::FLKAnimVerletConstraint_World(const UWorld* InWor
 	, bUseCapsuleCollisionForChain(InCollisionInput.bUseCapsuleCollisionForChain)
 	, BonePairs(InCollisionInput.SimulateBonePairIndicators)
 	, FrictionCoefficient(InCollisionInput.FrictionCoefficient)
+	, bUseAsyncQuery(InWorldCollisionInput.bUseAsyncQuery)
+	, bUseGeometryCache(InWorldCollisionInput.bUseGeometryCache)
+	, GeometryCacheMargin(InWorldCollisionInput.GeometryCacheMargin)
+	, bUseContactCache(InWorldCollisionInput.bUseContactCache)
+	, ContactCacheDistance(InWorldCollisionInput.ContactCacheDistance)
+	, ContactCacheMotionThreshold(InWorldCollisionInput.ContactCacheMotionThreshold)
+	, bUseChainEarlyOut(InWorldCollisionInput.bUseChainEarlyOut)
+	, ChainEarlyOutMargin(InWorldCollisionInput.ChainEarlyOutMargin)
+	, bSkipStationaryBones(InWorldCollisionInput.bSkipStationaryBones)
+	, StationaryThreshold(InWorldCollisionInput.StationaryThreshold)
 {
 	verify(WorldPtr.IsValid());
 	verify(SelfComponentPtr.IsValid());
@@ -32,10 +70,58 @@ void FLKAnimVerletConstraint_World::Update(float DeltaTime, bool bInitialUpdate,
 	if (WorldPtr.IsValid() == false || SelfComponentPtr.IsValid() == false)
 		return;
 
+	if (bUseGeometryCache)
+	{
+		/// Cached shapes are solved in every iteration. Only primitives that could not be cached still need sweeps.
+		if (bGeometryCacheNeedsSweep == false)
+			return;
+	}
+	else if (bUseAsyncQuery)
+	{
+		ApplyAsyncContactPlanes(DeltaTime);
+		return;
+	}
+
+	if (bUseChainEarlyOut && IsChainClearOfWorld(WorldPtr.Get(), SelfComponentPtr->GetComponentTransform()))
+	{
+		INC_DWORD_STAT(STAT_AnimVerlet_WorldCollision_ChainEarlyOutSkips);
+		return;
+	}
+
+	if (UseContactPlaneStorage())
+	{
+		const int32 NumElements = bUseCapsuleCollisionForChain ? BonePairs->Num() : Bones->Num();
+		if (CachedContactPlanes.Num() != NumElements)
+		{
+			CachedContactPlanes.Reset();
+			CachedContactPlanes.SetNum(NumElements);
+		}
+	}
+	ContactCacheHits = 0;
+	ContactCacheLookups = 0;
+	NumSkippedSweeps = 0;
+
+	const FTransform ComponentTransform = SelfComponentPtr->GetComponentTransform();
+	if (bHasPrevSweepComponentTransform == false)
+	{
+		PrevSweepComponentTransform = ComponentTransform;
+		bHasPrevSweepComponentTransform = true;
+	}
+
 	if (bUseCapsuleCollisionForChain)
 		CheckWorldCapsule(DeltaTime, bInitialUpdate, bFinalize);
 	else
 		CheckWorldSphere(DeltaTime, bInitialUpdate, bFinalize);
+
+	PrevSweepComponentTransform = ComponentTransform;
+	INC_DWORD_STAT_BY(STAT_AnimVerlet_WorldCollision_StationarySkippedSweeps, NumSkippedSweeps);
+
+	if (bUseContactCache && ContactCacheLookups > 0)
+	{
+		INC_DWORD_STAT_BY(STAT_AnimVerlet_WorldCollision_ContactCacheHits, ContactCacheHits);
+		INC_DWORD_STAT_BY(STAT_AnimVerlet_WorldCollision_ContactCacheLookups, ContactCacheLookups);
+		SET_FLOAT_STAT(STAT_AnimVerlet_WorldCollision_ContactCacheHitRate, static_cast<float>(ContactCacheHits) / static_cast<float>(ContactCacheLookups));
+	}
 }
 
 bool FLKAnimVerletConstraint_World::CheckWorldSphere(IN OUT FLKAnimVerletBone& CurVerletBone, float DeltaTime, bool bInitialUpdate, bool bFinalize, const UWorld* World, 
@@ -49,8 +135,21 @@ bool FLKAnimVerletConstraint_World::CheckWorldSphere(IN OUT FLKAnimVerletBone& C
 	const FVector PrevWorldLoc = ComponentTransform.TransformPosition(CurVerletBone.PrevLocation);
 	const FVector CurWorldLoc = ComponentTransform.TransformPosition(CurVerletBone.Location);
 
+	if (bSkipStationaryBones && HasStoredSweepResult(LambdaIndex) && IsStationaryBone(CurVerletBone, ComponentTransform))
+	{
+		++NumSkippedSweeps;
+		return ApplyCachedContactPlane(LambdaIndex, IN OUT CurVerletBone, nullptr, ComponentTransform);
+	}
+
+	if (bUseContactCache && FindCachedContactPlane(LambdaIndex, PrevWorldLoc, CurWorldLoc, CurWorldLoc, CurWorldLoc, CurVerletBone.Thickness) != nullptr)
+		return ApplyCachedContactPlane(LambdaIndex, IN OUT CurVerletBone, nullptr, ComponentTransform);
+
+	INC_DWORD_STAT(STAT_AnimVerlet_WorldCollision_SyncQueries);
 	FHitResult HitResult;
 	const bool bHit = World->SweepSingleByProfile(OUT HitResult, PrevWorldLoc, CurWorldLoc, FQuat::Identity, WorldCollisionProfileName, FCollisionShape::MakeSphere(CurVerletBone.Thickness), CollisionQueryParams);
+	if (UseContactPlaneStorage())
+		StoreCachedContactPlane(LambdaIndex, bHit ? &HitResult : nullptr, CurWorldLoc);
+
 	if (bHit)
 	{
 		const FVector LocationBeforeCorrection = CurVerletBone.Location;
@@ -111,25 +210,33 @@ bool FLKAnimVerletConstraint_World::CheckWorldCapsule(IN OUT FLKAnimVerletBone&
 	const FVector PrevWorldLoc = ComponentTransform.TransformPosition(PrevVerletBoneCenter);
 	const FVector CurWorldLoc = ComponentTransform.TransformPosition(VerletBoneCenter);
 
+	if (bSkipStationaryBones && HasStoredSweepResult(LambdaIndex) && IsStationaryBone(CurVerletBone, ComponentTransform) && IsStationaryBone(ParentVerletBone, ComponentTransform))
+	{
+		++NumSkippedSweeps;
+		return ApplyCachedContactPlane(LambdaIndex, IN OUT CurVerletBone, &ParentVerletBone, ComponentTransform);
+	}
+
+	if (bUseContactCache)
+	{
+		const FVector ParentWorldLoc = ComponentTransform.TransformPosition(ParentVerletBone.Location);
+		const FVector ChildWorldLoc = ComponentTransform.TransformPosition(CurVerletBone.Location);
+		if (FindCachedContactPlane(LambdaIndex, PrevWorldLoc, CurWorldLoc, ParentWorldLoc, ChildWorldLoc, CurVerletBone.Thickness) != nullptr)
+			return ApplyCachedContactPlane(LambdaIndex, IN OUT CurVerletBone, &ParentVerletBone, ComponentTransform);
+	}
+
+	INC_DWORD_STAT(STAT_AnimVerlet_WorldCollision_SyncQueries);
 	FHitResult HitResult;
 	const FVector LocalCapsuleDirection = DirFromParent.IsNearlyZero(KINDA_SMALL_NUMBER) ? FVector::UpVector : DirFromParent;
 	const FVector WorldCapsuleDirection = ComponentTransform.TransformVectorNoScale(LocalCapsuleDirection).GetSafeNormal();
 	const bool bHit = World->SweepSingleByProfile(OUT HitResult, PrevWorldLoc, CurWorldLoc, FRotationMatrix::MakeFromZ(-WorldCapsuleDirection).ToQuat(), WorldCollisionProfileName, FCollisionShape::MakeCapsule(CurVerletBone.Thickness, CapsuleHalfHeight), CollisionQueryParams);
+	if (UseContactPlaneStorage())
+		StoreCachedContactPlane(LambdaIndex, bHit ? &HitResult : nullptr, CurWorldLoc);
+
 	if (bHit)
 	{
 		const FVector CollisionNormal = ComponentTransform.InverseTransformVectorNoScale(HitResult.Normal).GetSafeNormal();
 		const FVector ContactPoint = ComponentTransform.InverseTransformPosition(HitResult.ImpactPoint);
 		const float ContactT = FMath::Clamp(FMath::IsNearlyZero(DistFromParent, KINDA_SMALL_NUMBER) ? 0.0f : (ContactPoint - ParentVerletBone.Location).Dot(DirFromParent) / DistFromParent, 0.0f, 1.0f);
-		float ParticleT = ContactT;
-		if (ParentVerletBone.IsPinned())
-			ParticleT = 1.0f;
-		if (CurVerletBone.IsPinned())
-			ParticleT = 0.0f;
-
-		const float B0 = 1.0f - ParticleT;
-		const float B1 = ParticleT;
-		const float W0 = ParentVerletBone.InvMass * B0 * B0;
-		const float W1 = CurVerletBone.InvMass * B1 * B1;
 
 		FVector Correction = FVector::ZeroVector;
 		if (HitResult.bStartPenetrating && HitResult.PenetrationDepth > 0.0f)
@@ -142,28 +249,45 @@ bool FLKAnimVerletConstraint_World::CheckWorldCapsule(IN OUT FLKAnimVerletBone&
 			Correction = ResolvedCenter - VerletBoneCenter;
 		}
 
-		float CorrectionDistance = 0.0f;
-		FVector CorrectionNormal = FVector::ZeroVector;
-		Correction.ToDirectionAndLength(OUT CorrectionNormal, OUT CorrectionDistance);
-		if (CorrectionDistance <= KINDA_SMALL_NUMBER)
-			return true;
+		return ApplyCapsuleCorrection(IN OUT CurVerletBone, IN OUT ParentVerletBone, ContactT, Correction, CollisionNormal);
+	}
+	return false;
+}
 
-		LkAnimVerletCollision::FLkRigidCapsuleContact RigidContact;
-		const bool bApplyRigidResponse = LkAnimVerletCollision::MakeRigidCapsuleContact(OUT RigidContact, ParentVerletBone, CurVerletBone, ContactT, CorrectionNormal);
-		const float GeneralizedInverseMass = bApplyRigidResponse ? RigidContact.GeneralizedInverseMass : W0 + W1;
-		if (GeneralizedInverseMass <= KINDA_SMALL_NUMBER)
-			return false;
-		const float FrictionB0 = bApplyRigidResponse ? 1.0f - ContactT : B0;
-		const float FrictionB1 = bApplyRigidResponse ? ContactT : B1;
+bool FLKAnimVerletConstraint_World::ApplyCapsuleCorrection(IN OUT FLKAnimVerletBone& CurVerletBone, IN OUT FLKAnimVerletBone& ParentVerletBone, float ContactT, 
+														   const FVector& Correction, const FVector& CollisionNormal)
+{
+	float ParticleT = ContactT;
+	if (ParentVerletBone.IsPinned())
+		ParticleT = 1.0f;
+	if (CurVerletBone.IsPinned())
+		ParticleT = 0.0f;
 
-		const float DeltaLambda = CorrectionDistance / GeneralizedInverseMass;
-		LkAnimVerletCollision::ApplyNormalCorrectionTwoBone(IN OUT ParentVerletBone, IN OUT CurVerletBone, RigidContact, CorrectionNormal, bApplyRigidResponse, DeltaLambda, B0, B1);
+	const float B0 = 1.0f - ParticleT;
+	const float B1 = ParticleT;
+	const float W0 = ParentVerletBone.InvMass * B0 * B0;
+	const float W1 = CurVerletBone.InvMass * B1 * B1;
 
-		const float NormalCorrectionMagnitude = FMath::Abs(Correction.Dot(CollisionNormal));
-		LkAnimVerletCollision::ApplyPBDCollisionFriction(IN OUT ParentVerletBone, IN OUT CurVerletBone, FrictionB0, FrictionB1, CollisionNormal, NormalCorrectionMagnitude, FrictionCoefficient);
+	float CorrectionDistance = 0.0f;
+	FVector CorrectionNormal = FVector::ZeroVector;
+	Correction.ToDirectionAndLength(OUT CorrectionNormal, OUT CorrectionDistance);
+	if (CorrectionDistance <= KINDA_SMALL_NUMBER)
 		return true;
-	}
-	return false;
+
+	LkAnimVerletCollision::FLkRigidCapsuleContact RigidContact;
+	const bool bApplyRigidResponse = LkAnimVerletCollision::MakeRigidCapsuleContact(OUT RigidContact, ParentVerletBone, CurVerletBone, ContactT, CorrectionNormal);
+	const float GeneralizedInverseMass = bApplyRigidResponse ? RigidContact.GeneralizedInverseMass : W0 + W1;
+	if (GeneralizedInverseMass <= KINDA_SMALL_NUMBER)
+		return false;
+	const float FrictionB0 = bApplyRigidResponse ? 1.0f - ContactT : B0;
+	const float FrictionB1 = bApplyRigidResponse ? ContactT : B1;
+
+	const float DeltaLambda = CorrectionDistance / GeneralizedInverseMass;
+	LkAnimVerletCollision::ApplyNormalCorrectionTwoBone(IN OUT ParentVerletBone, IN OUT CurVerletBone, RigidContact, CorrectionNormal, bApplyRigidResponse, DeltaLambda, B0, B1);
+
+	const float NormalCorrectionMagnitude = FMath::Abs(Correction.Dot(CollisionNormal));
+	LkAnimVerletCollision::ApplyPBDCollisionFriction(IN OUT ParentVerletBone, IN OUT CurVerletBone, FrictionB0, FrictionB1, CollisionNormal, NormalCorrectionMagnitude, FrictionCoefficient);
+	return true;
 }
 
 void FLKAnimVerletConstraint_World::CheckWorldCapsule(float DeltaTime, bool bInitialUpdate, bool bFinalize)
@@ -198,4 +322,596 @@ void FLKAnimVerletConstraint_World::CheckWorldCapsule(float DeltaTime, bool bIni
 		CheckWorldCapsule(IN OUT CurVerletBone, IN OUT ParentVerletBone, DeltaTime, bInitialUpdate, bFinalize, World, CollisionQueryParams, ComponentTransform, i);
 	}
 }
-///=========================================================================================================================================
\ No newline at end of file
+
+void FLKAnimVerletConstraint_World::ResetSimulation()
+{
+	bHasPrevSweepComponentTransform = false;
+	bChainEarlyOutClear = false;
+	CachedContactPlanes.Reset();
+
+	AsyncTraceHandles.Reset();
+	AsyncContactPlanes.Reset();
+	AsyncTraceIssuedFrame = 0;
+	AsyncTraceIssuedTime = 0.0;
+}
+
+void FLKAnimVerletConstraint_World::UpdateAsyncQueries_GameThread()
+{
+	check(IsInGameThread());
+
+	if (bUseAsyncQuery == false || bUseGeometryCache || WorldPtr.IsValid() == false || SelfComponentPtr.IsValid() == false)
+		return;
+
+	/// AsyncSweep/QueryTraceData are not const on UWorld, but they only touch the async trace buffers owned by the game thread
+	UWorld* World = const_cast<UWorld*>(WorldPtr.Get());
+	ConsumeAsyncQueries_GameThread(World);
+	IssueAsyncQueries_GameThread(World);
+}
+
+void FLKAnimVerletConstraint_World::ConsumeAsyncQueries_GameThread(UWorld* World)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AnimVerlet_WorldCollision_ConsumeAsyncQueries);
+	verify(World != nullptr);
+
+	const int32 NumElements = bUseCapsuleCollisionForChain ? BonePairs->Num() : Bones->Num();
+	if (AsyncContactPlanes.Num() != NumElements)
+	{
+		AsyncContactPlanes.Reset();
+		AsyncContactPlanes.SetNum(NumElements);
+	}
+
+	if (AsyncTraceHandles.Num() == 0)
+		return;
+
+	/// Results are only valid for the frame right after the request. Older handles are simply dropped.
+	const bool bResultFrame = (GFrameCounter == AsyncTraceIssuedFrame + 1);
+	for (int32 i = 0; i < AsyncTraceHandles.Num(); ++i)
+	{
+		const FTraceHandle& CurHandle = AsyncTraceHandles[i];
+		if (CurHandle.IsValid() == false || AsyncContactPlanes.IsValidIndex(i) == false)
+			continue;
+
+		FLKAnimVerletWorldContactPlane& CurPlane = AsyncContactPlanes[i];
+		if (bResultFrame == false)
+		{
+			/// The node was not updated last frame, so the plane is too old to trust
+			CurPlane.bValid = false;
+			continue;
+		}
+
+		FTraceDatum TraceDatum;
+		if (World->QueryTraceData(CurHandle, OUT TraceDatum) == false)
+		{
+			/// Keep the last known plane so a late batch does not drop contacts for a frame
+			INC_DWORD_STAT(STAT_AnimVerlet_WorldCollision_AsyncQueriesNotReady);
+			continue;
+		}
+
+		CurPlane.bValid = false;
+		for (const FHitResult& CurHit : TraceDatum.OutHits)
+		{
+			if (CurHit.bBlockingHit == false)
+				continue;
+
+			CurPlane.Normal = CurHit.ImpactNormal.GetSafeNormal();
+			CurPlane.Location = CurHit.ImpactPoint;
+			CurPlane.bValid = (CurPlane.Normal.IsNearlyZero() == false);
+			break;
+		}
+	}
+	AsyncTraceHandles.Reset();
+
+	SET_DWORD_STAT(STAT_AnimVerlet_WorldCollision_AsyncLatencyFrames, static_cast<uint32>(GFrameCounter - AsyncTraceIssuedFrame));
+	SET_FLOAT_STAT(STAT_AnimVerlet_WorldCollision_AsyncLatencyMs, static_cast<float>((FPlatformTime::Seconds() - AsyncTraceIssuedTime) * 1000.0));
+}
+
+void FLKAnimVerletConstraint_World::IssueAsyncQueries_GameThread(UWorld* World)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AnimVerlet_WorldCollision_IssueAsyncQueries);
+	verify(World != nullptr);
+
+	UPrimitiveComponent* SelfComponent = SelfComponentPtr.Get();
+
+	FCollisionQueryParams CollisionQueryParams(SCENE_QUERY_STAT(LKAnimVerlet));
+	CollisionQueryParams.AddIgnoredComponent(SelfComponent);
+	if (SelfComponent->GetOwner() != nullptr)
+		CollisionQueryParams.AddIgnoredActor(SelfComponent->GetOwner());
+
+	/// Sweep from the latest simulated location to the location predicted for the next frame.
+	/// The hit surface is kept as a plane, so the prediction only has to reach it, not match it exactly.
+	const FTransform ComponentTransform = SelfComponent->GetComponentTransform();
+	auto SweepSphere = [&](const FLKAnimVerletBone& CurVerletBone) -> FTraceHandle
+	{
+		const FVector Motion = CurVerletBone.Location - CurVerletBone.PrevLocation;
+		const FVector StartWorldLoc = ComponentTransform.TransformPosition(CurVerletBone.Location);
+		const FVector EndWorldLoc = ComponentTransform.TransformPosition(CurVerletBone.Location + Motion);
+		return World->AsyncSweepByProfile(EAsyncTraceType::Single, StartWorldLoc, EndWorldLoc, FQuat::Identity, WorldCollisionProfileName, 
+										  FCollisionShape::MakeSphere(CurVerletBone.Thickness), CollisionQueryParams);
+	};
+
+	AsyncTraceHandles.Reset();
+	if (bUseCapsuleCollisionForChain)
+	{
+		AsyncTraceHandles.SetNum(BonePairs->Num());
+		for (int32 i = 0; i < BonePairs->Num(); ++i)
+		{
+			const FLKAnimVerletBoneIndicatorPair& CurPair = (*BonePairs)[i];
+			if (ExcludeBones.IsValidIndex(CurPair.BoneB.AnimVerletBoneIndex) && ExcludeBones[CurPair.BoneB.AnimVerletBoneIndex])
+				continue;
+
+			verify(Bones->IsValidIndex(CurPair.BoneB.AnimVerletBoneIndex));
+			const FLKAnimVerletBone& CurVerletBone = (*Bones)[CurPair.BoneB.AnimVerletBoneIndex];
+			if (CurPair.BoneA.IsValidBoneIndicator() == false || CurVerletBone.bOverrideToUseSphereCollisionForChain)
+			{
+				if (CurVerletBone.IsPinned() == false)
+					AsyncTraceHandles[i] = SweepSphere(CurVerletBone);
+				continue;
+			}
+
+			verify(Bones->IsValidIndex(CurPair.BoneA.AnimVerletBoneIndex));
+			const FLKAnimVerletBone& ParentVerletBone = (*Bones)[CurPair.BoneA.AnimVerletBoneIndex];
+			if (ParentVerletBone.IsPinned() && CurVerletBone.IsPinned())
+				continue;
+
+			FVector DirFromParent = FVector::ZeroVector;
+			float DistFromParent = 0.0f;
+			(CurVerletBone.Location - ParentVerletBone.Location).ToDirectionAndLength(OUT DirFromParent, OUT DistFromParent);
+			const float CapsuleHalfHeight = DistFromParent * 0.5f + CurVerletBone.Thickness;
+
+			const FVector VerletBoneCenter = (CurVerletBone.Location + ParentVerletBone.Location) * 0.5f;
+			const FVector PrevVerletBoneCenter = (CurVerletBone.PrevLocation + ParentVerletBone.PrevLocation) * 0.5f;
+			const FVector StartWorldLoc = ComponentTransform.TransformPosition(VerletBoneCenter);
+			const FVector EndWorldLoc = ComponentTransform.TransformPosition(VerletBoneCenter + (VerletBoneCenter - PrevVerletBoneCenter));
+
+			const FVector LocalCapsuleDirection = DirFromParent.IsNearlyZero(KINDA_SMALL_NUMBER) ? FVector::UpVector : DirFromParent;
+			const FVector WorldCapsuleDirection = ComponentTransform.TransformVectorNoScale(LocalCapsuleDirection).GetSafeNormal();
+			AsyncTraceHandles[i] = World->AsyncSweepByProfile(EAsyncTraceType::Single, StartWorldLoc, EndWorldLoc, FRotationMatrix::MakeFromZ(-WorldCapsuleDirection).ToQuat(), WorldCollisionProfileName,
+															  FCollisionShape::MakeCapsule(CurVerletBone.Thickness, CapsuleHalfHeight), CollisionQueryParams);
+		}
+	}
+	else
+	{
+		AsyncTraceHandles.SetNum(Bones->Num());
+		for (int32 i = 0; i < Bones->Num(); ++i)
+		{
+			if (ExcludeBones.IsValidIndex(i) && ExcludeBones[i])
+				continue;
+
+			const FLKAnimVerletBone& CurVerletBone = (*Bones)[i];
+			if (CurVerletBone.IsPinned() == false)
+				AsyncTraceHandles[i] = SweepSphere(CurVerletBone);
+		}
+	}
+
+	int32 NumIssued = 0;
+	for (const FTraceHandle& CurHandle : AsyncTraceHandles)
+	{
+		if (CurHandle.IsValid())
+			++NumIssued;
+	}
+	INC_DWORD_STAT_BY(STAT_AnimVerlet_WorldCollision_AsyncQueries, NumIssued);
+
+	AsyncTraceIssuedFrame = GFrameCounter;
+	AsyncTraceIssuedTime = FPlatformTime::Seconds();
+}
+
+void FLKAnimVerletConstraint_World::ApplyAsyncContactPlanes(float DeltaTime)
+{
+	if (AsyncContactPlanes.Num() == 0)
+		return;
+
+	const FTransform ComponentTransform = SelfComponentPtr->GetComponentTransform();
+	for (int32 i = 0; i < AsyncContactPlanes.Num(); ++i)
+	{
+		const FLKAnimVerletWorldContactPlane& CurPlane = AsyncContactPlanes[i];
+		if (CurPlane.bValid == false)
+			continue;
+
+		const FVector PlaneLocation = ComponentTransform.InverseTransformPosition(CurPlane.Location);
+		const FVector PlaneNormal = ComponentTransform.InverseTransformVectorNoScale(CurPlane.Normal).GetSafeNormal();
+		if (bUseCapsuleCollisionForChain)
+		{
+			if (BonePairs->IsValidIndex(i) == false)
+				continue;
+
+			const FLKAnimVerletBoneIndicatorPair& CurPair = (*BonePairs)[i];
+			if (Bones->IsValidIndex(CurPair.BoneB.AnimVerletBoneIndex) == false)
+				continue;
+
+			/// Same response as the sync sweep: sphere pairs stay spheres and capsules distribute the correction along the segment
+			FLKAnimVerletBone& CurVerletBone = (*Bones)[CurPair.BoneB.AnimVerletBoneIndex];
+			if (CurPair.BoneA.IsValidBoneIndicator() && Bones->IsValidIndex(CurPair.BoneA.AnimVerletBoneIndex) && CurVerletBone.bOverrideToUseSphereCollisionForChain == false)
+				ApplyContactPlaneCapsule(IN OUT CurVerletBone, IN OUT (*Bones)[CurPair.BoneA.AnimVerletBoneIndex], PlaneLocation, PlaneNormal);
+			else
+				ApplyContactPlane(IN OUT CurVerletBone, PlaneLocation, PlaneNormal);
+		}
+		else
+		{
+			if (Bones->IsValidIndex(i) == false)
+				continue;
+
+			ApplyContactPlane(IN OUT (*Bones)[i], PlaneLocation, PlaneNormal);
+		}
+	}
+}
+
+bool FLKAnimVerletConstraint_World::ApplyContactPlane(IN OUT FLKAnimVerletBone& CurVerletBone, const FVector& PlaneLocation, const FVector& PlaneNormal)
+{
+	if (CurVerletBone.IsPinned())
+		return false;
+
+	const float DistToPlane = FVector::PointPlaneDist(CurVerletBone.Location, PlaneLocation, PlaneNormal);
+	if (DistToPlane >= CurVerletBone.Thickness)
+		return false;
+
+	const float PenetrationDepth = (CurVerletBone.Thickness - DistToPlane);
+	CurVerletBone.Location += (PlaneNormal * PenetrationDepth);
+	LkAnimVerletCollision::ApplyPBDCollisionFriction(IN OUT CurVerletBone, PlaneNormal, PenetrationDepth, FrictionCoefficient);
+	return true;
+}
+
+bool FLKAnimVerletConstraint_World::ApplyContactPlaneCapsule(IN OUT FLKAnimVerletBone& CurVerletBone, IN OUT FLKAnimVerletBone& ParentVerletBone, const FVector& PlaneLocation, const FVector& PlaneNormal)
+{
+	if (ParentVerletBone.IsPinned() && CurVerletBone.IsPinned())
+		return false;
+
+	const float ParentPenetration = FMath::Max(CurVerletBone.Thickness - FVector::PointPlaneDist(ParentVerletBone.Location, PlaneLocation, PlaneNormal), 0.0f);
+	const float CurPenetration = FMath::Max(CurVerletBone.Thickness - FVector::PointPlaneDist(CurVerletBone.Location, PlaneLocation, PlaneNormal), 0.0f);
+	const float PenetrationSum = ParentPenetration + CurPenetration;
+	if (PenetrationSum <= KINDA_SMALL_NUMBER)
+		return false;
+
+	/// The contact point leans toward the deeper end(an end for a tilted segment, the middle for one lying on the plane)
+	const float ContactT = CurPenetration / PenetrationSum;
+	const FVector Correction = PlaneNormal * FMath::Max(ParentPenetration, CurPenetration);
+	return ApplyCapsuleCorrection(IN OUT CurVerletBone, IN OUT ParentVerletBone, ContactT, Correction, PlaneNormal);
+}
+
+bool FLKAnimVerletConstraint_World::MakeSweptChainBound(OUT FLKAnimVerletBound& OutBound, float Margin) const
+{
+	bool bValidBound = false;
+	for (int32 i = 0; i < Bones->Num(); ++i)
+	{
+		if (ExcludeBones.IsValidIndex(i) && ExcludeBones[i])
+			continue;
+
+		const FLKAnimVerletBone& CurVerletBone = (*Bones)[i];
+		const FVector HalfExtents(CurVerletBone.Thickness + Margin);
+		const FVector PredictedLocation = CurVerletBone.Location + (CurVerletBone.Location - CurVerletBone.PrevLocation);
+		const FLKAnimVerletBound CurBound = FLKAnimVerletBound::MakeBoundFromCenterHalfExtents(CurVerletBone.Location, HalfExtents)
+										  + FLKAnimVerletBound::MakeBoundFromCenterHalfExtents(PredictedLocation, HalfExtents);
+		if (bValidBound)
+		{
+			OutBound += CurBound;
+		}
+		else
+		{
+			OutBound = CurBound;
+			bValidBound = true;
+		}
+	}
+	return bValidBound;
+}
+
+bool FLKAnimVerletConstraint_World::IsChainClearOfWorld(const UWorld* World, const FTransform& ComponentTransform)
+{
+	verify(World != nullptr);
+
+	/// Tight world bound of this step's motion(previous to current location of every bone)
+	FLKAnimVerletBound StepBound;
+	bool bValidBound = false;
+	for (int32 i = 0; i < Bones->Num(); ++i)
+	{
+		if (ExcludeBones.IsValidIndex(i) && ExcludeBones[i])
+			continue;
+
+		const FLKAnimVerletBone& CurVerletBone = (*Bones)[i];
+		const FVector HalfExtents(CurVerletBone.Thickness);
+		const FLKAnimVerletBound CurBound = FLKAnimVerletBound::MakeBoundFromCenterHalfExtents(ComponentTransform.TransformPosition(CurVerletBone.Location), HalfExtents)
+										  + FLKAnimVerletBound::MakeBoundFromCenterHalfExtents(ComponentTransform.TransformPosition(CurVerletBone.PrevLocation), HalfExtents);
+		if (bValidBound)
+		{
+			StepBound += CurBound;
+		}
+		else
+		{
+			StepBound = CurBound;
+			bValidBound = true;
+		}
+	}
+	if (bValidBound == false)
+		return true;
+
+	if (bChainEarlyOutClear && ChainEarlyOutBound.IsInsideOrOn(StepBound))
+		return true;
+
+	UPrimitiveComponent* SelfComponent = SelfComponentPtr.Get();
+	FCollisionQueryParams CollisionQueryParams(SCENE_QUERY_STAT(LKAnimVerlet));
+	CollisionQueryParams.AddIgnoredComponent(SelfComponent);
+	if (SelfComponent->GetOwner() != nullptr)
+		CollisionQueryParams.AddIgnoredActor(SelfComponent->GetOwner());
+
+	ChainEarlyOutBound = StepBound;
+	ChainEarlyOutBound.Expand(ChainEarlyOutMargin);
+
+	INC_DWORD_STAT(STAT_AnimVerlet_WorldCollision_ChainEarlyOutQueries);
+	bChainEarlyOutClear = (World->OverlapAnyTestByProfile(ChainEarlyOutBound.GetCenter(), FQuat::Identity, WorldCollisionProfileName, 
+														  FCollisionShape::MakeBox(ChainEarlyOutBound.GetHalfExtents()), CollisionQueryParams) == false);
+	return bChainEarlyOutClear;
+}
+
+void FLKAnimVerletConstraint_World::UpdateGeometryCache()
+{
+	SCOPE_CYCLE_COUNTER(STAT_AnimVerlet_WorldCollision_UpdateGeometryCache);
+
+	bGeometryCacheNeedsSweep = false;
+	CachedSpheres.Reset();
+	CachedCapsules.Reset();
+	CachedBoxes.Reset();
+	CachedConvexes.Reset();
+
+	if (bUseGeometryCache == false || WorldPtr.IsValid() == false || SelfComponentPtr.IsValid() == false)
+		return;
+
+	FLKAnimVerletBound ChainBound;
+	if (MakeSweptChainBound(OUT ChainBound, GeometryCacheMargin) == false)
+		return;
+
+	const UWorld* World = WorldPtr.Get();
+	UPrimitiveComponent* SelfComponent = SelfComponentPtr.Get();
+
+	FCollisionQueryParams CollisionQueryParams(SCENE_QUERY_STAT(LKAnimVerlet));
+	CollisionQueryParams.AddIgnoredComponent(SelfComponent);
+	if (SelfComponent->GetOwner() != nullptr)
+		CollisionQueryParams.AddIgnoredActor(SelfComponent->GetOwner());
+
+	/// The component space bound becomes an oriented box in world space
+	const FTransform ComponentTransform = SelfComponent->GetComponentTransform();
+	const FVector WorldCenter = ComponentTransform.TransformPosition(ChainBound.GetCenter());
+	const FVector WorldHalfExtents = ChainBound.GetHalfExtents() * ComponentTransform.GetScale3D().GetAbs();
+
+	INC_DWORD_STAT(STAT_AnimVerlet_WorldCollision_GeometryCacheQueries);
+	TArray<FOverlapResult> Overlaps;
+	World->OverlapMultiByProfile(OUT Overlaps, WorldCenter, ComponentTransform.GetRotation(), WorldCollisionProfileName, FCollisionShape::MakeBox(WorldHalfExtents), CollisionQueryParams);
+	for (const FOverlapResult& CurOverlap : Overlaps)
+	{
+		const UPrimitiveComponent* OverlappedComponent = CurOverlap.GetComponent();
+		if (OverlappedComponent == nullptr)
+			continue;
+
+		AddPrimitiveToGeometryCache(*OverlappedComponent, CurOverlap.ItemIndex);
+	}
+
+	INC_DWORD_STAT_BY(STAT_AnimVerlet_WorldCollision_GeometryCacheShapes, CachedSpheres.Num() + CachedCapsules.Num() + CachedBoxes.Num() + CachedConvexes.Num());
+}
+
+void FLKAnimVerletConstraint_World::AddPrimitiveToGeometryCache(const UPrimitiveComponent& InPrimitive, int32 InBodyIndex)
+{
+	const FBodyInstance* BodyInstance = InPrimitive.GetBodyInstance(NAME_None, true, InBodyIndex);
+	const UBodySetup* BodySetup = BodyInstance != nullptr ? BodyInstance->GetBodySetup() : InPrimitive.GetBodySetup();
+	if (BodySetup == nullptr || BodySetup->AggGeom.GetElementCount() == 0)
+	{
+		/// Heightfields and complex-only meshes have no simple shapes to cache
+		bGeometryCacheNeedsSweep = true;
+		return;
+	}
+
+	const FTransform PrimitiveWorldTransform = InPrimitive.GetComponentTransform();
+	const FVector BodyScale = BodyInstance != nullptr ? BodyInstance->Scale3D : PrimitiveWorldTransform.GetScale3D();
+	const FTransform BodyWorldTransform = LkAnimVerlet::GetBodyWorldTransform(BodyInstance, PrimitiveWorldTransform);
+
+	FLKAnimVerletCollisionShapeList ShapeList;
+	LkAnimVerlet::AddBodySetupShapes(OUT ShapeList, *BodySetup, BodyScale, BodyWorldTransform);
+	for (const FLKAnimVerletCollisionSphere& CurSphere : ShapeList.SphereCollisionShapes)
+	{
+		FLKAnimVerletWorldCachedShape& CachedShape = CachedSpheres.Emplace_GetRef();
+		CachedShape.Location = CurSphere.LocationOffset;
+		CachedShape.HalfExtents = FVector(CurSphere.Radius, CurSphere.Radius, CurSphere.Radius);
+	}
+	for (const FLKAnimVerletCollisionCapsule& CurCapsule : ShapeList.CapsuleCollisionShapes)
+	{
+		FLKAnimVerletWorldCachedShape& CachedShape = CachedCapsules.Emplace_GetRef();
+		CachedShape.Location = CurCapsule.LocationOffset;
+		CachedShape.Rotation = CurCapsule.RotationOffset.Quaternion();
+		CachedShape.HalfExtents = FVector(CurCapsule.Radius, CurCapsule.Radius, CurCapsule.HalfHeight);
+	}
+	for (const FLKAnimVerletCollisionBox& CurBox : ShapeList.BoxCollisionShapes)
+	{
+		FLKAnimVerletWorldCachedShape& CachedShape = CachedBoxes.Emplace_GetRef();
+		CachedShape.Location = CurBox.LocationOffset;
+		CachedShape.Rotation = CurBox.RotationOffset.Quaternion();
+		CachedShape.HalfExtents = CurBox.HalfExtents;
+	}
+
+	/// Convex hulls are kept as their face planes
+	const FTransform ScaledBodyWorldTransform(BodyWorldTransform.GetRotation(), BodyWorldTransform.GetLocation(), BodyScale);
+	for (const FKConvexElem& CurConvexElem : BodySetup->AggGeom.ConvexElems)
+	{
+		const FTransform ConvexWorldTransform = CurConvexElem.GetTransform() * ScaledBodyWorldTransform;
+		const TArray<FVector>& VertexData = CurConvexElem.VertexData;
+		const TArray<int32>& IndexData = CurConvexElem.IndexData;
+		if (VertexData.Num() < 4 || IndexData.Num() < 3)
+			continue;
+
+		FVector Centroid = FVector::ZeroVector;
+		for (const FVector& CurVertex : VertexData)
+			Centroid += CurVertex;
+		Centroid = ConvexWorldTransform.TransformPosition(Centroid / static_cast<float>(VertexData.Num()));
+
+		FLKAnimVerletWorldCachedConvex& CachedConvex = CachedConvexes.Emplace_GetRef();
+		for (int32 i = 0; i + 2 < IndexData.Num(); i += 3)
+		{
+			const FVector V0 = ConvexWorldTransform.TransformPosition(VertexData[IndexData[i]]);
+			const FVector V1 = ConvexWorldTransform.TransformPosition(VertexData[IndexData[i + 1]]);
+			const FVector V2 = ConvexWorldTransform.TransformPosition(VertexData[IndexData[i + 2]]);
+			FVector FaceNormal = (V1 - V0).Cross(V2 - V0);
+			if (FaceNormal.Normalize() == false)
+				continue;
+
+			/// Do not rely on the index winding(mirrored scale flips it). Faces always point away from the centroid.
+			if ((V0 - Centroid).Dot(FaceNormal) < 0.0f)
+				FaceNormal = -FaceNormal;
+
+			const FPlane FacePlane(V0, FaceNormal);
+			const bool bDuplicated = CachedConvex.Planes.ContainsByPredicate([&FacePlane](const FPlane& Other)
+			{
+				return FVector(Other).Dot(FVector(FacePlane)) > 0.9999f && FMath::Abs(Other.W - FacePlane.W) < 0.01f;
+			});
+			if (bDuplicated == false)
+				CachedConvex.Planes.Emplace(FacePlane);
+		}
+
+		if (CachedConvex.Planes.Num() < 4)
+			CachedConvexes.Pop();
+	}
+}
+
+void FLKAnimVerletConstraint_World::PrepareGeometryCache(const FTransform& ComponentTransform)
+{
+	const FMatrix WorldToComponent = ComponentTransform.ToMatrixWithScale().Inverse();
+	for (FLKAnimVerletWorldCachedConvex& CurConvex : CachedConvexes)
+	{
+		CurConvex.PlanesInCS.Reset();
+		for (const FPlane& CurPlane : CurConvex.Planes)
+		{
+			FPlane PlaneInCS = CurPlane.TransformBy(WorldToComponent);
+			const float NormalSize = FVector(PlaneInCS).Size();
+			if (NormalSize <= KINDA_SMALL_NUMBER)
+				continue;
+
+			PlaneInCS /= NormalSize;
+			CurConvex.PlanesInCS.Emplace(PlaneInCS);
+		}
+	}
+}
+
+void FLKAnimVerletConstraint_World::SolveGeometryCache(float DeltaTime, bool bInitialUpdate, bool bFinalize)
+{
+	if (bUseGeometryCache == false || CachedConvexes.Num() == 0)
+		return;
+
+	for (int32 i = 0; i < Bones->Num(); ++i)
+	{
+		if (ExcludeBones.IsValidIndex(i) && ExcludeBones[i])
+			continue;
+
+		FLKAnimVerletBone& CurVerletBone = (*Bones)[i];
+		for (const FLKAnimVerletWorldCachedConvex& CurConvex : CachedConvexes)
+			CheckConvexSphere(IN OUT CurVerletBone, CurConvex);
+	}
+}
+
+bool FLKAnimVerletConstraint_World::CheckConvexSphere(IN OUT FLKAnimVerletBone& CurVerletBone, const FLKAnimVerletWorldCachedConvex& InConvex)
+{
+	if (CurVerletBone.IsPinned() || InConvex.PlanesInCS.Num() == 0)
+		return false;
+
+	/// The least penetrated face of the thickness-inflated hull is the separating direction
+	float MaxDist = -UE_BIG_NUMBER;
+	int32 MaxPlaneIndex = INDEX_NONE;
+	for (int32 i = 0; i < InConvex.PlanesInCS.Num(); ++i)
+	{
+		const float CurDist = InConvex.PlanesInCS[i].PlaneDot(CurVerletBone.Location);
+		if (CurDist >= CurVerletBone.Thickness)
+			return false;
+
+		if (CurDist > MaxDist)
+		{
+			MaxDist = CurDist;
+			MaxPlaneIndex = i;
+		}
+	}
+
+	const FVector PlaneNormal(InConvex.PlanesInCS[MaxPlaneIndex]);
+	const float PenetrationDepth = (CurVerletBone.Thickness - MaxDist);
+	CurVerletBone.Location += (PlaneNormal * PenetrationDepth);
+	LkAnimVerletCollision::ApplyPBDCollisionFriction(IN OUT CurVerletBone, PlaneNormal, PenetrationDepth, FrictionCoefficient);
+	return true;
+}
+
+const FLKAnimVerletWorldContactPlane* FLKAnimVerletConstraint_World::FindCachedContactPlane(int32 ElementIndex, const FVector& PrevWorldLoc, const FVector& CurWorldLoc, 
+																							const FVector& EndAWorldLoc, const FVector& EndBWorldLoc, float Radius)
+{
+	++ContactCacheLookups;
+	if (CachedContactPlanes.IsValidIndex(ElementIndex) == false)
+		return nullptr;
+
+	const FLKAnimVerletWorldContactPlane& CachedPlane = CachedContactPlanes[ElementIndex];
+	if (CachedPlane.bValid == false)
+		return nullptr;
+
+	/// Fast motion may reach other geometry within the step
+	if (FVector::DistSquared(PrevWorldLoc, CurWorldLoc) > FMath::Square(ContactCacheMotionThreshold))
+		return nullptr;
+
+	/// The cached plane is infinite. Sliding away from where it was found(e.g. off a ledge) needs a new query.
+	const float RegionRadius = Radius + ContactCacheDistance;
+	if (FVector::DistSquared(CachedPlane.QueryLocation, CurWorldLoc) > FMath::Square(RegionRadius))
+		return nullptr;
+
+	/// Penetrated through, or left the plane
+	const float MinDistToPlane = FMath::Min(FVector::PointPlaneDist(EndAWorldLoc, CachedPlane.Location, CachedPlane.Normal), 
+											FVector::PointPlaneDist(EndBWorldLoc, CachedPlane.Location, CachedPlane.Normal));
+	if (MinDistToPlane < 0.0f || MinDistToPlane > RegionRadius)
+		return nullptr;
+
+	++ContactCacheHits;
+	return &CachedPlane;
+}
+
+void FLKAnimVerletConstraint_World::StoreCachedContactPlane(int32 ElementIndex, const FHitResult* HitResultNullable, const FVector& QueryWorldLoc)
+{
+	if (CachedContactPlanes.IsValidIndex(ElementIndex) == false)
+		return;
+
+	FLKAnimVerletWorldContactPlane& CachedPlane = CachedContactPlanes[ElementIndex];
+	CachedPlane.bSwept = true;
+	CachedPlane.bValid = false;
+	if (HitResultNullable == nullptr || HitResultNullable->bBlockingHit == false)
+		return;
+
+	CachedPlane.Location = HitResultNullable->ImpactPoint;
+	CachedPlane.Normal = HitResultNullable->ImpactNormal.GetSafeNormal();
+	CachedPlane.QueryLocation = QueryWorldLoc;
+	CachedPlane.bValid = (CachedPlane.Normal.IsNearlyZero() == false);
+}
+
+bool FLKAnimVerletConstraint_World::IsStationaryBone(const FLKAnimVerletBone& InVerletBone, const FTransform& ComponentTransform) const
+{
+	return IsStationaryMotion(InVerletBone, ComponentTransform, PrevSweepComponentTransform, StationaryThreshold, bInertialFrame);
+}
+
+bool FLKAnimVerletConstraint_World::IsStationaryMotion(const FLKAnimVerletBone& InVerletBone, const FTransform& ComponentTransform, const FTransform& PrevComponentTransform, float InThreshold, bool bInInertialFrame)
+{
+	/// PrevLocation is in the current component frame(rebased by FLKAnimVerletBone::Update or never moved by it), so both points use the current transform like the sweep
+	const FVector PrevWorldLoc = ComponentTransform.TransformPosition(InVerletBone.PrevLocation);
+	const FVector CurWorldLoc = ComponentTransform.TransformPosition(InVerletBone.Location);
+	if (FVector::DistSquared(PrevWorldLoc, CurWorldLoc) > FMath::Square(InThreshold))
+		return false;
+
+	/// Sleeping bones and every bone of the inertial frame are not rebased. They ride along with the component, so the component movement is also their world movement.
+	if (InVerletBone.IsSleep() || bInInertialFrame)
+		return (FVector::DistSquared(PrevComponentTransform.TransformPosition(InVerletBone.Location), CurWorldLoc) <= FMath::Square(InThreshold));
+	return true;
+}
+
+bool FLKAnimVerletConstraint_World::HasStoredSweepResult(int32 ElementIndex) const
+{
+	return (CachedContactPlanes.IsValidIndex(ElementIndex) && CachedContactPlanes[ElementIndex].bSwept);
+}
+
+bool FLKAnimVerletConstraint_World::ApplyCachedContactPlane(int32 ElementIndex, IN OUT FLKAnimVerletBone& CurVerletBone, FLKAnimVerletBone* ParentVerletBoneNullable, const FTransform& ComponentTransform)
+{
+	if (CachedContactPlanes.IsValidIndex(ElementIndex) == false || CachedContactPlanes[ElementIndex].bValid == false)
+		return false;
+
+	const FLKAnimVerletWorldContactPlane& CachedPlane = CachedContactPlanes[ElementIndex];
+	const FVector PlaneLocation = ComponentTransform.InverseTransformPosition(CachedPlane.Location);
+	const FVector PlaneNormal = ComponentTransform.InverseTransformVectorNoScale(CachedPlane.Normal).GetSafeNormal();
+
+	/// Same response as the sweep and the async planes: capsules distribute the correction along the segment
+	if (ParentVerletBoneNullable != nullptr && CurVerletBone.bOverrideToUseSphereCollisionForChain == false)
+		return ApplyContactPlaneCapsule(IN OUT CurVerletBone, IN OUT *ParentVerletBoneNullable, PlaneLocation, PlaneNormal);
+	return ApplyContactPlane(IN OUT CurVerletBone, PlaneLocation, PlaneNormal);
+}
+///=========================================================================================================================================
@@ -0,0 +1,119 @@
+#include "LKAnimVerletShareRegistry.h"
+
+#include <Misc/ScopeLock.h>
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("AnimVerlet_Share_Groups"), STAT_AnimVerlet_Share_Groups, STATGROUP_Anim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AnimVerlet_Share_Members"), STAT_AnimVerlet_Share_Members, STATGROUP_Anim);
+
+/// Members not updated for this many frames belong to destroyed or inactive nodes
+static constexpr uint64 LKG_SHARE_STALE_FRAMES = 4;
+
+LKAnimVerletShareRegistry& LKAnimVerletShareRegistry::Get()
+{
+	static LKAnimVerletShareRegistry Registry;
+	return Registry;
+}
+
+bool LKAnimVerletShareRegistry::UpdateMember(IN OUT int32& InOutHandle, uint32 InShareKey)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	if (LastPruneFrame != GFrameCounter)
+	{
+		LastPruneFrame = GFrameCounter;
+		PruneStaleMembers();
+	}
+
+	FLKShareMember* FoundMember = (InOutHandle != INDEX_NONE) ? Members.Find(InOutHandle) : nullptr;
+	if (FoundMember == nullptr)
+	{
+		InOutHandle = NextHandle++;
+		FoundMember = &Members.Emplace(InOutHandle);
+		FoundMember->ShareKey = InShareKey;
+		++Groups.FindOrAdd(InShareKey).NumMembers;
+	}
+	else if (FoundMember->ShareKey != InShareKey)
+	{
+		LeaveGroup(InOutHandle, FoundMember->ShareKey);
+		FoundMember->ShareKey = InShareKey;
+		++Groups.FindOrAdd(InShareKey).NumMembers;
+	}
+	FoundMember->LastUpdateFrame = GFrameCounter;
+
+	/// The leader keeps its role while it updates every frame. A leader that missed a frame is replaced by the next member.
+	FLKShareGroup& Group = Groups.FindChecked(InShareKey);
+	if (Group.LeaderHandle != InOutHandle && Group.LeaderHandle != INDEX_NONE && Group.LeaderUpdateFrame + 1 >= GFrameCounter)
+		return false;
+
+	Group.LeaderHandle = InOutHandle;
+	Group.LeaderUpdateFrame = GFrameCounter;
+	return true;
+}
+
+void LKAnimVerletShareRegistry::PublishResult(int32 InHandle, const TArray<FLKAnimVerletCachedBoneResult>& InResult)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	const FLKShareMember* FoundMember = Members.Find(InHandle);
+	if (FoundMember == nullptr)
+		return;
+
+	FLKShareGroup* FoundGroup = Groups.Find(FoundMember->ShareKey);
+	if (FoundGroup == nullptr || FoundGroup->LeaderHandle != InHandle)
+		return;
+
+	FoundGroup->LatestResultIndex = (FoundGroup->LatestResultIndex + 1) % UE_ARRAY_COUNT(FoundGroup->ResultHistory);
+	FoundGroup->ResultHistory[FoundGroup->LatestResultIndex] = InResult;
+	FoundGroup->NumResults = FMath::Min(FoundGroup->NumResults + 1, static_cast<int32>(UE_ARRAY_COUNT(FoundGroup->ResultHistory)));
+}
+
+bool LKAnimVerletShareRegistry::CopyResult(int32 InHandle, int32 InPhaseOffsetFrames, OUT TArray<FLKAnimVerletCachedBoneResult>& OutResult) const
+{
+	FScopeLock ScopeLock(&Lock);
+
+	const FLKShareMember* FoundMember = Members.Find(InHandle);
+	if (FoundMember == nullptr)
+		return false;
+
+	const FLKShareGroup* FoundGroup = Groups.Find(FoundMember->ShareKey);
+	if (FoundGroup == nullptr || FoundGroup->NumResults == 0)
+		return false;
+
+	/// Until the history is filled, the oldest available result is used
+	const int32 PhaseOffsetFrames = FMath::Clamp(InPhaseOffsetFrames, 0, FoundGroup->NumResults - 1);
+	const int32 HistorySize = UE_ARRAY_COUNT(FoundGroup->ResultHistory);
+	OutResult = FoundGroup->ResultHistory[(FoundGroup->LatestResultIndex - PhaseOffsetFrames + HistorySize) % HistorySize];
+	return true;
+}
+
+void LKAnimVerletShareRegistry::LeaveGroup(int32 InHandle, uint32 InShareKey)
+{
+	FLKShareGroup* FoundGroup = Groups.Find(InShareKey);
+	if (FoundGroup == nullptr)
+		return;
+
+	if (--FoundGroup->NumMembers <= 0)
+	{
+		Groups.Remove(InShareKey);
+		return;
+	}
+
+	/// Keep the published results so the followers have something to apply until a new leader publishes
+	if (FoundGroup->LeaderHandle == InHandle)
+		FoundGroup->LeaderHandle = INDEX_NONE;
+}
+
+void LKAnimVerletShareRegistry::PruneStaleMembers()
+{
+	for (auto MemberIt = Members.CreateIterator(); MemberIt; ++MemberIt)
+	{
+		if (MemberIt.Value().LastUpdateFrame + LKG_SHARE_STALE_FRAMES < GFrameCounter)
+		{
+			LeaveGroup(MemberIt.Key(), MemberIt.Value().ShareKey);
+			MemberIt.RemoveCurrent();
+		}
+	}
+
+	SET_DWORD_STAT(STAT_AnimVerlet_Share_Groups, Groups.Num());
+	SET_DWORD_STAT(STAT_AnimVerlet_Share_Members, Members.Num());
+}
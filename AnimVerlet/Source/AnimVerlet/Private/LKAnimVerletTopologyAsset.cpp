@@ -0,0 +1,293 @@
+#include "LKAnimVerletTopologyAsset.h"
+
+#include <Serialization/MemoryReader.h>
+#include <Serialization/MemoryWriter.h>
+
+/// Bump when the blob layout or the settings the topology depends on change. Older blobs are dropped on load and the node builds at runtime.
+static constexpr int32 LKG_TOPOLOGY_ASSET_VERSION = 2;
+
+namespace LkAnimVerlet
+{
+	/// Bone pointers of the constraints as indices. >= 0 : SimulateBones, <= -2 : CustomDistanceConstraintBones(-2 - Index), INDEX_NONE : nullptr
+	static int32 ToTopologyBoneSlot(const FLKAnimVerletBone* InBoneNullable, const FLKAnimVerletSimulationTopology& InTopology)
+	{
+		if (InBoneNullable == nullptr)
+			return INDEX_NONE;
+
+		const FLKAnimVerletBone* SimulateBonesData = InTopology.SimulateBones.GetData();
+		if (InBoneNullable >= SimulateBonesData && InBoneNullable < SimulateBonesData + InTopology.SimulateBones.Num())
+			return static_cast<int32>(InBoneNullable - SimulateBonesData);
+
+		const int32 AnchorIndex = static_cast<int32>(InBoneNullable - InTopology.CustomDistanceConstraintBones.GetData());
+		verify(InTopology.CustomDistanceConstraintBones.IsValidIndex(AnchorIndex));
+		return -2 - AnchorIndex;
+	}
+
+	static FLKAnimVerletBone* FromTopologyBoneSlot(int32 InSlot, FLKAnimVerletSimulationTopology& InTopology)
+	{
+		if (InSlot >= 0)
+			return InTopology.SimulateBones.IsValidIndex(InSlot) ? &InTopology.SimulateBones[InSlot] : nullptr;
+
+		const int32 AnchorIndex = -2 - InSlot;
+		return InTopology.CustomDistanceConstraintBones.IsValidIndex(AnchorIndex) ? &InTopology.CustomDistanceConstraintBones[AnchorIndex] : nullptr;
+	}
+
+	template <typename TFunc> static void ForEachBonePointer(FLKAnimVerletConstraint_Pin& InConstraint, TFunc&& Func) { Func(InConstraint.Bone); }
+	template <typename TFunc> static void ForEachBonePointer(FLKAnimVerletConstraint_Distance& InConstraint, TFunc&& Func) { Func(InConstraint.BoneA); Func(InConstraint.BoneB); }
+	template <typename TFunc> static void ForEachBonePointer(FLKAnimVerletConstraint_IsometricBending& InConstraint, TFunc&& Func) { Func(InConstraint.BoneA); Func(InConstraint.BoneB); Func(InConstraint.BoneC); Func(InConstraint.BoneD); }
+	template <typename TFunc> static void ForEachBonePointer(FLKAnimVerletConstraint_Bending_1D& InConstraint, TFunc&& Func) { Func(InConstraint.BoneA); Func(InConstraint.BoneB); Func(InConstraint.BoneC); }
+	template <typename TFunc> static void ForEachBonePointer(FLKAnimVerletConstraint_FlatBending& InConstraint, TFunc&& Func) { Func(InConstraint.BoneA); Func(InConstraint.BoneB); Func(InConstraint.BoneC); Func(InConstraint.BoneD); }
+	template <typename TFunc> static void ForEachBonePointer(FLKAnimVerletConstraint_Straighten& InConstraint, TFunc&& Func) { Func(InConstraint.BoneA); Func(InConstraint.BoneB); Func(InConstraint.BoneC); }
+	template <typename TFunc> static void ForEachBonePointer(FLKAnimVerletConstraint_FixedDistance& InConstraint, TFunc&& Func) { Func(InConstraint.BoneA); Func(InConstraint.BoneB); }
+	template <typename TFunc> static void ForEachBonePointer(FLKAnimVerletConstraint_BallSocket& InConstraint, TFunc&& Func) { Func(InConstraint.BoneA); Func(InConstraint.BoneB); Func(InConstraint.GrandParentBoneNullable); Func(InConstraint.ParentBoneNullable); }
+
+	/// Every constraint array built before activation. Collision constraints are built on the node at activation.
+	template <typename TFunc>
+	static void ForEachBakedConstraints(FLKAnimVerletSimulationTopology& InTopology, TFunc&& Func)
+	{
+		Func(InTopology.PinConstraints);
+		Func(InTopology.DistanceConstraints);
+		Func(InTopology.BendingConstraints);
+		Func(InTopology.BendingConstraints_1D);
+		Func(InTopology.FlatBendingConstraints);
+		Func(InTopology.StraightenConstraints);
+		Func(InTopology.FixedDistanceConstraints);
+		Func(InTopology.BallSocketConstraints);
+	}
+
+	static void SerializeConstraintValues(FArchive& Ar, FLKAnimVerletConstraint_Pin& InConstraint)
+	{
+		Ar << InConstraint.PinMargin;
+	}
+	static void SerializeConstraintValues(FArchive& Ar, FLKAnimVerletConstraint_Distance& InConstraint)
+	{
+		Ar << InConstraint.bUseXPBDSolver << InConstraint.bStretchEachBone << InConstraint.StretchStrength << InConstraint.Stiffness << InConstraint.Length;
+		Ar << InConstraint.MinDistance << InConstraint.MaxDistance << InConstraint.Lambda << InConstraint.Compliance;
+		Ar << InConstraint.bUseDistanceRange << InConstraint.bUsePoseDistanceAsRange << InConstraint.ActiveDistanceRange;
+	}
+	static void SerializeConstraintValues(FArchive& Ar, FLKAnimVerletConstraint_IsometricBending& InConstraint)
+	{
+		Ar << InConstraint.bUseXPBDSolver;
+		for (int32 Row = 0; Row < 4; ++Row)
+		{
+			for (int32 Column = 0; Column < 4; ++Column)
+				Ar << InConstraint.Q[Row][Column];
+		}
+		Ar << InConstraint.RestEnergy << InConstraint.RestDihedralAngle << InConstraint.Stiffness << InConstraint.MaxStiffness;
+		Ar << InConstraint.Lambda << InConstraint.Compliance << InConstraint.MinCompliance << InConstraint.MaxAngleRadians;
+	}
+	static void SerializeConstraintValues(FArchive& Ar, FLKAnimVerletConstraint_Bending_1D& InConstraint)
+	{
+		Ar << InConstraint.bUseXPBDSolver << InConstraint.RestAngle << InConstraint.Stiffness << InConstraint.MaxStiffness;
+		Ar << InConstraint.Lambda << InConstraint.Compliance << InConstraint.MinCompliance << InConstraint.MaxAngleRadians;
+	}
+	static void SerializeConstraintValues(FArchive& Ar, FLKAnimVerletConstraint_FlatBending& InConstraint)
+	{
+		Ar << InConstraint.bUseXPBDSolver << InConstraint.Stiffness << InConstraint.MaxStiffness;
+		Ar << InConstraint.Lambda << InConstraint.Compliance << InConstraint.MinCompliance << InConstraint.MaxAngleRadians;
+		Ar << InConstraint.RestAngle << InConstraint.TargetAngle << InConstraint.FlatAlpha;
+	}
+	static void SerializeConstraintValues(FArchive& Ar, FLKAnimVerletConstraint_Straighten& InConstraint)
+	{
+		Ar << InConstraint.StraightenStrength << InConstraint.bStraightenCenterBone;
+	}
+	static void SerializeConstraintValues(FArchive& Ar, FLKAnimVerletConstraint_FixedDistance& InConstraint)
+	{
+		Ar << InConstraint.bStretchEachBone << InConstraint.bAwayFromEachOther << InConstraint.StretchStrength << InConstraint.Length << InConstraint.LengthMargin;
+	}
+	static void SerializeConstraintValues(FArchive& Ar, FLKAnimVerletConstraint_BallSocket& InConstraint)
+	{
+		Ar << InConstraint.AngleDegrees << InConstraint.AngleOffset << InConstraint.bUseXPBDSolver << InConstraint.Compliance << InConstraint.Lambda;
+	}
+
+	static void SerializeBoneBase(FArchive& Ar, FLKAnimVerletBoneBase& InBone)
+	{
+		/// Compact pose indices depend on the required bones of the running mesh LOD. They are initialized again on load.
+		Ar << InBone.BoneReference.BoneName;
+		Ar << InBone.PoseLocation << InBone.Location << InBone.PoseRotation << InBone.Rotation << InBone.PoseScale;
+	}
+
+	static void SerializeBone(FArchive& Ar, FLKAnimVerletBone& InBone)
+	{
+		SerializeBoneBase(Ar, InBone);
+		Ar << InBone.ParentVerletBoneIndex << InBone.ChildVerletBoneIndexes;
+		Ar << InBone.bTipBone << InBone.bFakeBone << InBone.bSubDividedBone << InBone.bUseXPBDSolver << InBone.InvMass;
+		Ar << InBone.FakeBoneLocationOffset << InBone.FakeBoneLengthFromParent << InBone.SideStraightenDirInLocal;
+		Ar << InBone.PrevPoseLocation << InBone.PrevLocation << InBone.GravityAlignedPoseLocation << InBone.GravityAlignedPoseDiff;
+		Ar << InBone.PrevPoseRotation << InBone.PrevRotation << InBone.PoseDirFromParent << InBone.GravityAlignedPoseDirFromParent;
+		Ar << InBone.MoveDelta << InBone.Velocity << InBone.bSleep << InBone.SleepTriggerElapsedTime;
+		Ar << InBone.bPinned << InBone.PinMargin << InBone.bConstrainConeAngleFromParent << InBone.ConeAngleConstraint << InBone.ConeAngleOffset;
+		Ar << InBone.Thickness << InBone.bOverrideToUseSphereCollisionForChain;
+	}
+
+	static void SerializeExcludedBone(FArchive& Ar, FLKAnimVerletExcludedBone& InBone)
+	{
+		SerializeBoneBase(Ar, InBone);
+		Ar << InBone.ParentVerletBoneIndex << InBone.ParentExcludedBoneIndex << InBone.LengthToParent << InBone.bStraightenExcludedBonesByParent;
+		Ar << InBone.bChainResolutionSkipped << InBone.InterpolationChildVerletBoneIndex << InBone.InterpolationAlpha;
+	}
+
+	static void SerializeBoneIndicator(FArchive& Ar, FLKAnimVerletBoneIndicator& InIndicator)
+	{
+		Ar << InIndicator.AnimVerletBoneIndex << InIndicator.bExcludedBone << InIndicator.ParentAnimVerletBoneIndex << InIndicator.bParentExcludedBone;
+	}
+
+	template <typename TElement, typename TFunc>
+	static void SerializeTopologyArray(FArchive& Ar, TArray<TElement>& InArray, TFunc&& SerializeElement)
+	{
+		int32 NumElements = InArray.Num();
+		Ar << NumElements;
+		if (Ar.IsLoading())
+		{
+			if (NumElements < 0)
+			{
+				Ar.SetError();
+				return;
+			}
+			InArray.Reset(NumElements);
+			InArray.AddDefaulted(NumElements);
+		}
+
+		for (TElement& CurElement : InArray)
+		{
+			if (Ar.IsError())
+				return;
+			SerializeElement(Ar, CurElement);
+		}
+	}
+
+	/// Bones first, constraints point into them. Returns false when a loaded constraint points out of the bone arrays.
+	static bool SerializeTopology(FArchive& Ar, FLKAnimVerletSimulationTopology& InTopology)
+	{
+		SerializeTopologyArray(Ar, InTopology.SimulateBones, [](FArchive& InAr, FLKAnimVerletBone& InBone) { SerializeBone(InAr, InBone); });
+		SerializeTopologyArray(Ar, InTopology.CustomDistanceConstraintBones, [](FArchive& InAr, FLKAnimVerletBone& InBone) { SerializeBone(InAr, InBone); });
+		SerializeTopologyArray(Ar, InTopology.ExcludedBones, [](FArchive& InAr, FLKAnimVerletExcludedBone& InBone) { SerializeExcludedBone(InAr, InBone); });
+		SerializeTopologyArray(Ar, InTopology.RelevantBoneIndicators, [](FArchive& InAr, FLKAnimVerletBoneIndicator& InIndicator) { SerializeBoneIndicator(InAr, InIndicator); });
+		SerializeTopologyArray(Ar, InTopology.SimulateBonePairIndicators, [](FArchive& InAr, FLKAnimVerletBoneIndicatorPair& InPair) {
+			SerializeBoneIndicator(InAr, InPair.BoneA);
+			SerializeBoneIndicator(InAr, InPair.BoneB);
+		});
+		SerializeTopologyArray(Ar, InTopology.SimulateBoneTriangleIndicators, [](FArchive& InAr, FLKAnimVerletBoneIndicatorTriangle& InTriangle) {
+			SerializeBoneIndicator(InAr, InTriangle.BoneA);
+			SerializeBoneIndicator(InAr, InTriangle.BoneB);
+			SerializeBoneIndicator(InAr, InTriangle.BoneC);
+		});
+		Ar << InTopology.BoneChainIndexes << InTopology.MaxBoneChainLength << InTopology.MaxThickness;
+
+		bool bValidBonePointers = true;
+		ForEachBakedConstraints(InTopology, [&Ar, &InTopology, &bValidBonePointers](auto& InConstraints) {
+			SerializeTopologyArray(Ar, InConstraints, [&InTopology, &bValidBonePointers](FArchive& InAr, auto& InConstraint) {
+				ForEachBonePointer(InConstraint, [&InAr, &InTopology, &bValidBonePointers](FLKAnimVerletBone*& InOutBone) {
+					int32 BoneSlot = InAr.IsLoading() ? INDEX_NONE : ToTopologyBoneSlot(InOutBone, InTopology);
+					InAr << BoneSlot;
+					if (InAr.IsLoading())
+					{
+						InOutBone = (BoneSlot != INDEX_NONE) ? FromTopologyBoneSlot(BoneSlot, InTopology) : nullptr;
+						bValidBonePointers &= (BoneSlot == INDEX_NONE || InOutBone != nullptr);
+					}
+				});
+				SerializeConstraintValues(InAr, InConstraint);
+			});
+		});
+		return bValidBonePointers;
+	}
+}
+
+///=========================================================================================================================================
+/// ULKAnimVerletTopologyAsset
+///=========================================================================================================================================
+void ULKAnimVerletTopologyAsset::Serialize(FArchive& Ar)
+{
+	Super::Serialize(Ar);
+
+	if (Ar.IsLoading() == false && Ar.IsSaving() == false)
+		return;
+
+	/// A blob keeps the package readable when the layout changes. An unknown version is skipped whole.
+	int32 TopologyVersion = LKG_TOPOLOGY_ASSET_VERSION;
+	TArray<uint8> TopologyData;
+	if (Ar.IsSaving() && bValidTopology)
+	{
+		FMemoryWriter TopologyWriter(TopologyData);
+		LkAnimVerlet::SerializeTopology(TopologyWriter, Topology);
+	}
+	Ar << TopologyVersion;
+	Ar << TopologyData;
+
+	if (Ar.IsLoading())
+	{
+		FLKAnimVerletSimulationTopology LoadedTopology;
+		bool bLoaded = false;
+		if (TopologyVersion == LKG_TOPOLOGY_ASSET_VERSION && TopologyData.Num() > 0)
+		{
+			FMemoryReader TopologyReader(TopologyData);
+			bLoaded = LkAnimVerlet::SerializeTopology(TopologyReader, LoadedTopology);
+			bLoaded = bLoaded && (TopologyReader.IsError() == false) && (LoadedTopology.SimulateBones.Num() > 0);
+		}
+
+		FLKAnimVerletSimulationTopology PrevTopology;
+		SetTopology(bLoaded ? LoadedTopology : PrevTopology, SettingsHash, SkeletonHash);
+	}
+}
+
+void ULKAnimVerletTopologyAsset::CopyTopology(OUT FLKAnimVerletSimulationTopology& OutTopology) const
+{
+	OutTopology.SimulateBones = Topology.SimulateBones;
+	OutTopology.CustomDistanceConstraintBones = Topology.CustomDistanceConstraintBones;
+	OutTopology.ExcludedBones = Topology.ExcludedBones;
+	OutTopology.RelevantBoneIndicators = Topology.RelevantBoneIndicators;
+	OutTopology.SimulateBonePairIndicators = Topology.SimulateBonePairIndicators;
+	OutTopology.SimulateBoneTriangleIndicators = Topology.SimulateBoneTriangleIndicators;
+	OutTopology.BoneChainIndexes = Topology.BoneChainIndexes;
+	OutTopology.MaxBoneChainLength = Topology.MaxBoneChainLength;
+	OutTopology.MaxThickness = Topology.MaxThickness;
+
+	/// Same layout on both sides, so the index of a bone in the baked arrays is its index in the copies
+	OutTopology.PinConstraints = Topology.PinConstraints;
+	OutTopology.DistanceConstraints = Topology.DistanceConstraints;
+	OutTopology.BendingConstraints = Topology.BendingConstraints;
+	OutTopology.BendingConstraints_1D = Topology.BendingConstraints_1D;
+	OutTopology.FlatBendingConstraints = Topology.FlatBendingConstraints;
+	OutTopology.StraightenConstraints = Topology.StraightenConstraints;
+	OutTopology.FixedDistanceConstraints = Topology.FixedDistanceConstraints;
+	OutTopology.BallSocketConstraints = Topology.BallSocketConstraints;
+	LkAnimVerlet::ForEachBakedConstraints(OutTopology, [this, &OutTopology](auto& InConstraints) {
+		for (auto& CurConstraint : InConstraints)
+		{
+			LkAnimVerlet::ForEachBonePointer(CurConstraint, [this, &OutTopology](FLKAnimVerletBone*& InOutBone) {
+				if (InOutBone != nullptr)
+					InOutBone = LkAnimVerlet::FromTopologyBoneSlot(LkAnimVerlet::ToTopologyBoneSlot(InOutBone, Topology), OutTopology);
+			});
+		}
+	});
+}
+
+void ULKAnimVerletTopologyAsset::SetTopology(IN OUT FLKAnimVerletSimulationTopology& InOutTopology, uint32 InSettingsHash, uint32 InSkeletonHash)
+{
+	/// Swapping keeps the allocations, so the bone pointers of the constraints stay valid
+	Swap(Topology.SimulateBones, InOutTopology.SimulateBones);
+	Swap(Topology.CustomDistanceConstraintBones, InOutTopology.CustomDistanceConstraintBones);
+	Swap(Topology.ExcludedBones, InOutTopology.ExcludedBones);
+	Swap(Topology.RelevantBoneIndicators, InOutTopology.RelevantBoneIndicators);
+	Swap(Topology.SimulateBonePairIndicators, InOutTopology.SimulateBonePairIndicators);
+	Swap(Topology.SimulateBoneTriangleIndicators, InOutTopology.SimulateBoneTriangleIndicators);
+	Swap(Topology.BoneChainIndexes, InOutTopology.BoneChainIndexes);
+	Swap(Topology.MaxBoneChainLength, InOutTopology.MaxBoneChainLength);
+	Swap(Topology.MaxThickness, InOutTopology.MaxThickness);
+	Swap(Topology.PinConstraints, InOutTopology.PinConstraints);
+	Swap(Topology.DistanceConstraints, InOutTopology.DistanceConstraints);
+	Swap(Topology.BendingConstraints, InOutTopology.BendingConstraints);
+	Swap(Topology.BendingConstraints_1D, InOutTopology.BendingConstraints_1D);
+	Swap(Topology.FlatBendingConstraints, InOutTopology.FlatBendingConstraints);
+	Swap(Topology.StraightenConstraints, InOutTopology.StraightenConstraints);
+	Swap(Topology.FixedDistanceConstraints, InOutTopology.FixedDistanceConstraints);
+	Swap(Topology.BallSocketConstraints, InOutTopology.BallSocketConstraints);
+
+	SettingsHash = InSettingsHash;
+	SkeletonHash = InSkeletonHash;
+	bValidTopology = (Topology.SimulateBones.Num() > 0);
+	NumSimulateBones = Topology.SimulateBones.Num();
+	NumConstraints = 0;
+	LkAnimVerlet::ForEachBakedConstraints(Topology, [this](const auto& InConstraints) { NumConstraints += InConstraints.Num(); });
+}
+///=========================================================================================================================================
\ No newline at end of file
@@ -0,0 +1,111 @@
+#include <CoreMinimal.h>
+#include <Misc/AutomationTest.h>
+#include "LKAnimNode_AnimVerlet.h"
+#include "LKAnimVerletBone.h"
+#include "LKAnimVerletConstraint_Collision.h"
+#include "LKAnimVerletSetting.h"
+#include "LKAnimVerletTopologyAsset.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+namespace LkAnimVerletTest
+{
+	constexpr float LKG_STATIONARY_THRESHOLD = 0.01f;
+
+	/// One simulation step of a bone at InLocation(component space) while the component moves from PrevComponentT to ComponentT
+	FLKAnimVerletBone MakeSteppedBone(const FVector& InLocation, const FTransform& ComponentT, const FTransform& PrevComponentT, bool bSleep)
+	{
+		FLKAnimVerletBone VerletBone;
+		VerletBone.InitializeTransform(FTransform(InLocation));
+		VerletBone.PrepareSimulation(FTransform(InLocation), FVector::ZeroVector);
+		if (bSleep)
+			VerletBone.Sleep();
+
+		FLKAnimVerletUpdateParam UpdateParam;
+		UpdateParam.ComponentMoveDiff = ComponentT.InverseTransformPosition(PrevComponentT.GetLocation());
+		UpdateParam.ComponentRotDiff = ComponentT.InverseTransformRotation(PrevComponentT.GetRotation());
+
+		/// Sleeping bones ride along with the component frame(same as PreUpdateBones)
+		VerletBone.Update(1.0f / 30.0f, UpdateParam, bSleep == false);
+		return VerletBone;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLKAnimVerletStationaryMotionTest, "AnimVerlet.WorldCollision.StationaryMotion", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FLKAnimVerletStationaryMotionTest::RunTest(const FString& Parameters)
+{
+	using namespace LkAnimVerletTest;
+
+	const FVector BoneLocation(10.0f, 0.0f, 50.0f);
+	const FTransform PrevComponentT(FRotator(0.0f, 30.0f, 0.0f), FVector(200.0f, -50.0f, 0.0f));
+	const FTransform MovedComponentT(FRotator(0.0f, 45.0f, 0.0f), FVector(300.0f, -50.0f, 0.0f));
+
+	/// Component at rest
+	{
+		const FLKAnimVerletBone AwakeBone = MakeSteppedBone(BoneLocation, PrevComponentT, PrevComponentT, false);
+		TestTrue(TEXT("Awake bone with a still component is stationary"), FLKAnimVerletConstraint_World::IsStationaryMotion(AwakeBone, PrevComponentT, PrevComponentT, LKG_STATIONARY_THRESHOLD, false));
+
+		const FLKAnimVerletBone SleepingBone = MakeSteppedBone(BoneLocation, PrevComponentT, PrevComponentT, true);
+		TestTrue(TEXT("Sleeping bone with a still component is stationary"), FLKAnimVerletConstraint_World::IsStationaryMotion(SleepingBone, PrevComponentT, PrevComponentT, LKG_STATIONARY_THRESHOLD, false));
+	}
+
+	/// Moving component
+	{
+		/// Left behind by inertia: rebased into the moved frame, but still at the same world location
+		const FLKAnimVerletBone InertiaBone = MakeSteppedBone(BoneLocation, MovedComponentT, PrevComponentT, false);
+		TestTrue(TEXT("Awake bone left in place in world space is stationary"), FLKAnimVerletConstraint_World::IsStationaryMotion(InertiaBone, MovedComponentT, PrevComponentT, LKG_STATIONARY_THRESHOLD, false));
+
+		/// Pulled back to its component space location by constraints: moved with the component in world space
+		FLKAnimVerletBone HeldBone = MakeSteppedBone(BoneLocation, MovedComponentT, PrevComponentT, false);
+		HeldBone.Location = BoneLocation;
+		TestFalse(TEXT("Awake bone held still in component space is not stationary"), FLKAnimVerletConstraint_World::IsStationaryMotion(HeldBone, MovedComponentT, PrevComponentT, LKG_STATIONARY_THRESHOLD, false));
+
+		const FLKAnimVerletBone SleepingBone = MakeSteppedBone(BoneLocation, MovedComponentT, PrevComponentT, true);
+		TestFalse(TEXT("Sleeping bone carried by the component is not stationary"), FLKAnimVerletConstraint_World::IsStationaryMotion(SleepingBone, MovedComponentT, PrevComponentT, LKG_STATIONARY_THRESHOLD, false));
+	}
+
+	/// Inertial frame: awake bones are not rebased either, so a bone held still in component space moves with the component
+	{
+		const FLKAnimVerletBone StillBone = MakeSteppedBone(BoneLocation, PrevComponentT, PrevComponentT, false);
+		TestTrue(TEXT("Inertial frame bone with a still component is stationary"), FLKAnimVerletConstraint_World::IsStationaryMotion(StillBone, PrevComponentT, PrevComponentT, LKG_STATIONARY_THRESHOLD, true));
+		TestFalse(TEXT("Inertial frame bone carried by the moving component is not stationary"), FLKAnimVerletConstraint_World::IsStationaryMotion(StillBone, MovedComponentT, PrevComponentT, LKG_STATIONARY_THRESHOLD, true));
+
+		const FTransform TurnedComponentT(FRotator(0.0f, 45.0f, 0.0f), PrevComponentT.GetLocation());
+		TestFalse(TEXT("Inertial frame bone carried by the turning component is not stationary"), FLKAnimVerletConstraint_World::IsStationaryMotion(StillBone, TurnedComponentT, PrevComponentT, LKG_STATIONARY_THRESHOLD, true));
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLKAnimVerletTopologyAssetStaleTest, "AnimVerlet.TopologyAsset.FlatBendingSettingsStale", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FLKAnimVerletTopologyAssetStaleTest::RunTest(const FString& Parameters)
+{
+	constexpr uint32 SkeletonHash = 1234u;
+	const FLKAnimNode_AnimVerlet BakedNode;
+	const uint32 BakedSettingsHash = BakedNode.CalculateTopologySettingsHash();
+
+	ULKAnimVerletTopologyAsset* TopologyAsset = NewObject<ULKAnimVerletTopologyAsset>();
+	FLKAnimVerletSimulationTopology BakedTopology;
+	BakedTopology.SimulateBones.AddDefaulted();
+	TopologyAsset->SetTopology(IN OUT BakedTopology, BakedSettingsHash, SkeletonHash);
+	TestTrue(TEXT("Asset baked with the same settings is up to date"), TopologyAsset->IsUpToDate(FLKAnimNode_AnimVerlet().CalculateTopologySettingsHash(), SkeletonHash));
+
+	const TFunction<void(FLKAnimNode_AnimVerlet&)> SettingChanges[] = {
+		[](FLKAnimNode_AnimVerlet& InNode) { InNode.bUseFlatBendingComplianceRange = !InNode.bUseFlatBendingComplianceRange; },
+		[](FLKAnimNode_AnimVerlet& InNode) { InNode.InvFlatBendingComplianceMin *= 2.0f; },
+		[](FLKAnimNode_AnimVerlet& InNode) { InNode.InvFlatBendingComplianceMax *= 2.0f; },
+		[](FLKAnimNode_AnimVerlet& InNode) { InNode.FlatBendingComplianceMaxAngle += 10.0f; },
+		[](FLKAnimNode_AnimVerlet& InNode) { InNode.bUseFlatBendingStiffnessRange = !InNode.bUseFlatBendingStiffnessRange; },
+		[](FLKAnimNode_AnimVerlet& InNode) { InNode.FlatBendingStiffnessMin *= 0.5f; },
+		[](FLKAnimNode_AnimVerlet& InNode) { InNode.FlatBendingStiffnessMax *= 0.5f; },
+		[](FLKAnimNode_AnimVerlet& InNode) { InNode.FlatBendingStiffnessMaxAngle += 10.0f; },
+	};
+	for (int32 i = 0; i < UE_ARRAY_COUNT(SettingChanges); ++i)
+	{
+		FLKAnimNode_AnimVerlet ChangedNode;
+		SettingChanges[i](ChangedNode);
+		TestFalse(FString::Printf(TEXT("Asset is stale after flat bending setting change %d"), i), TopologyAsset->IsUpToDate(ChangedNode.CalculateTopologySettingsHash(), SkeletonHash));
+	}
+
+	return true;
+}
+#endif
\ No newline at end of file
@@ -1,13 +1,16 @@
 #pragma once
 #include <CoreMinimal.h>
 #include <BoneControllers/AnimNode_SkeletalControlBase.h>
+#include <Tasks/Task.h>
 #include "LKAnimVerletBone.h"
 #include "LKAnimVerletBroadphaseContainer.h"
+#include "LKAnimVerletBudgetScheduler.h"
 #include "LKAnimVerletCollisionShape.h"
 #include "LKAnimVerletConstraint.h"
 #include "LKAnimVerletConstraint_Collision.h"
 #include "LKAnimVerletConstraintType.h"
 #include "LKAnimVerletSetting.h"
+#include "LKAnimVerletShareRegistry.h"
 #include "LKAnimVerletType.h"
 #include "LKAnimNode_AnimVerlet.generated.h"
 
@@ -19,6 +22,44 @@
 
 #define LK_ENABLE_STAT	(1)
 
+///=========================================================================================================================================
+/// FLKAnimVerletSimulationTopology
+/// Bones, constraints and broadphase built for one LOD. Constraints point into these arrays, so a topology is only swapped with the node, never copied.
+/// ULKAnimVerletTopologyAsset is the exception. It copies the baked arrays and rebases the pointers.
+///=========================================================================================================================================
+struct FLKAnimVerletSimulationTopology
+{
+public:
+	TArray<FLKAnimVerletBone> SimulateBones;
+	TArray<FLKAnimVerletExcludedBone> ExcludedBones;
+	TArray<FLKAnimVerletBoneIndicator> RelevantBoneIndicators;
+	TArray<FLKAnimVerletBoneIndicatorPair> SimulateBonePairIndicators;
+	TArray<FLKAnimVerletBoneIndicatorTriangle> SimulateBoneTriangleIndicators;
+	LKAnimVerletBroadphaseContainer BroadphaseContainer;
+
+	TArray<FLKAnimVerletConstraint_Pin> PinConstraints;
+	TArray<FLKAnimVerletConstraint_Distance> DistanceConstraints;
+	TArray<FLKAnimVerletConstraint_IsometricBending> BendingConstraints;
+	TArray<FLKAnimVerletConstraint_Bending_1D> BendingConstraints_1D;
+	TArray<FLKAnimVerletConstraint_FlatBending> FlatBendingConstraints;
+	TArray<FLKAnimVerletConstraint_Straighten> StraightenConstraints;
+	TArray<FLKAnimVerletConstraint_FixedDistance> FixedDistanceConstraints;
+	TArray<FLKAnimVerletConstraint_BallSocket> BallSocketConstraints;
+	TArray<FLKAnimVerletConstraint_Sphere> SphereCollisionConstraints;
+	TArray<FLKAnimVerletConstraint_Capsule> CapsuleCollisionConstraints;
+	TArray<FLKAnimVerletConstraint_Box> BoxCollisionConstraints;
+	TArray<FLKAnimVerletConstraint_Plane> PlaneCollisionConstraints;
+	TArray<FLKAnimVerletConstraint_World> WorldCollisionConstraints;
+	TArray<FLKAnimVerletConstraint_Self> SelfCollisionConstraints;
+	TArray<FLKAnimVerletBone> CustomDistanceConstraintBones;
+	TArray<TArray<int32>> BoneChainIndexes;
+	int32 MaxBoneChainLength = 0;
+	float MaxThickness = 0.0f;
+	TExcludeBoneBits WorldCollisionExcludeBoneBits;
+	TArray<FLKAnimVerletSleepIsland> SleepIslands;
+	TArray<int32> SimulateBoneIslandIndexes;
+};
+
 
 USTRUCT(BlueprintInternalUseOnly)
 struct ANIMVERLET_API FLKAnimNode_AnimVerlet : public FAnimNode_SkeletalControlBase
@@ -27,6 +68,7 @@ struct ANIMVERLET_API FLKAnimNode_AnimVerlet : public FAnimNode_SkeletalControlB
 
 public:
 	FLKAnimNode_AnimVerlet();
+	virtual ~FLKAnimNode_AnimVerlet();
 
 public:
 	virtual void Initialize_AnyThread(const FAnimationInitializeContext& Context) override;
@@ -35,6 +77,8 @@ public:
 
 	virtual void EvaluateSkeletalControl_AnyThread(FComponentSpacePoseContext& Output, TArray<FBoneTransform>& OutBoneTransforms) override;
 	virtual void UpdateInternal(const FAnimationUpdateContext& Context) override;
+	virtual bool HasPreUpdate() const override;
+	virtual void PreUpdate(const UAnimInstance* InAnimInstance) override;
 
 protected:
 	virtual void InitializeBoneReferences(const FBoneContainer& RequiredBones) override;
@@ -42,34 +86,90 @@ protected:
 
 private:
 	void InitializeSimulateBones(FComponentSpacePoseContext& PoseContext, const FBoneContainer& BoneContainer);
+	void BuildSimulationTopology(FCSPose<FCompactPose>& Pose, const FBoneContainer& BoneContainer);
+	void ActivateSimulationTopology(FComponentSpacePoseContext& PoseContext, const FBoneContainer& BoneContainer);
+	void LaunchAsyncTopologyBuild(const FBoneContainer& BoneContainer);
+	bool ActivateAsyncTopology(FComponentSpacePoseContext& PoseContext, const FBoneContainer& BoneContainer);
+	void CancelAsyncTopologyBuild();
+	bool LoadTopologyAsset(FComponentSpacePoseContext& PoseContext, const FBoneContainer& BoneContainer);
+	bool HasAllSimulationBoneReferences() const;
 	void RebuildSimulationForLOD(FComponentSpacePoseContext& PoseContext, const FBoneContainer& BoneContainer);
-	void InitializeCustomDistanceConstraints(FComponentSpacePoseContext& PoseContext, const FBoneContainer& BoneContainer);
-	struct FLKAnimVerletBone* FindOrAddCustomDistanceConstraintBone(const FBoneReference& BoneReference, FComponentSpacePoseContext& PoseContext, const FBoneContainer& BoneContainer);
+	bool RestoreCachedLODTopology(uint32 InTopologyKey, const FBoneContainer& BoneContainer);
+	void SwapSimulationTopology(IN OUT FLKAnimVerletSimulationTopology& InOutTopology);
+	uint32 MakeLODTopologyKey() const;
+	void InitializeSimulationBoneReferences(const FBoneContainer& RequiredBones);
+	void ApplyLODFeatureOverrides(int32 LODLevel, OUT bool& bOutChainCollisionShapeChanged, OUT bool& bOutChainResolutionChanged);
+	void RebuildChainCollisionConstraints(FComponentSpacePoseContext& PoseContext, const FBoneContainer& BoneContainer);
+	void InitializeCustomDistanceConstraints(FCSPose<FCompactPose>& Pose, const FBoneContainer& BoneContainer);
+	struct FLKAnimVerletBone* FindOrAddCustomDistanceConstraintBone(const FBoneReference& BoneReference, FCSPose<FCompactPose>& Pose, const FBoneContainer& BoneContainer);
 	void InitializeBroadphase();
+	void InitializeChainCollisionConstraints(FComponentSpacePoseContext& PoseContext, const FBoneContainer& BoneContainer);
+	bool ShouldUseCapsuleCollisionForChain() const { return bUseCapsuleCollisionForChain && bLODAllowCapsuleCollisionForChain; }
+	void GatherCollisionShapes(OUT FLKAnimVerletCollisionShapeList& OutShapeList, const FBoneContainer& BoneContainer) const;
 	void InitializeLocalCollisionConstraints(const FBoneContainer& BoneContainer);
 	void InitializeAttachedShape(struct FLKAnimVerletCollisionShape& InShape, const FBoneContainer& BoneContainer);
-	bool MakeSimulateBones(FComponentSpacePoseContext& PoseContext, const FBoneContainer& BoneContainer, const FReferenceSkeleton& ReferenceSkeleton, int32 BoneIndex, 
+	bool MakeSimulateBones(FCSPose<FCompactPose>& Pose, const FBoneContainer& BoneContainer, const FReferenceSkeleton& ReferenceSkeleton, int32 BoneIndex, 
 						   int32 ParentSimulateBoneIndex, int32 RootSimulateBoneIndex, const FLKAnimVerletBoneSetting& BoneSetting, bool bParentExcluded, int32 ParentExcludedBoneIndex);
-	bool WalkChildsAndMakeSimulateBones(FComponentSpacePoseContext& PoseContext, const FBoneContainer& BoneContainer, const FReferenceSkeleton& ReferenceSkeleton, int32 BoneIndex, 
+	bool WalkChildsAndMakeSimulateBones(FCSPose<FCompactPose>& Pose, const FBoneContainer& BoneContainer, const FReferenceSkeleton& ReferenceSkeleton, int32 BoneIndex, 
 										int32 ParentSimulateBoneIndex, int32 RootSimulateBoneIndex, const FLKAnimVerletBoneSetting& BoneSetting, bool bParentExcluded, int32 ParentExcludedBoneIndex);
 	void MakeFakeBoneTransform(OUT FTransform& OutTransform, int32 ParentSimulateBoneIndex, float InFakeBoneLength) const;
+	bool IsChainResolutionSkippedBone(const FBoneContainer& BoneContainer, const FReferenceSkeleton& ReferenceSkeleton, int32 BoneIndex, const FLKAnimVerletBoneSetting& BoneSetting) const;
+	void LinkChainResolutionSkippedBones(int32 LastSkippedBoneIndex, int32 ChildSimulateBoneIndex);
 
 	void UpdateDeltaTime(float InDeltaTime, float InTimeDilation);
 	FQuat CalculateGravityAlignmentRotation(const FTransform& ComponentTransform) const;
 	void PrepareSimulation(FComponentSpacePoseContext& PoseContext, const FBoneContainer& BoneContainer, const FTransform& ComponentTransform);
+	void PrepareSimulateBonePoses(FComponentSpacePoseContext& PoseContext, const FBoneContainer& BoneContainer, const FTransform& ComponentTransform);
 	void PrepareLocalCollisionConstraints(FComponentSpacePoseContext& PoseContext, const FBoneContainer& BoneContainer, const FTransform& ComponentTransform);
 	void ConvertPhysicsAssetToShape(OUT FLKAnimVerletCollisionShapeList& OutShapeList, const class UPhysicsAsset& InPhysicsAsset, const FBoneContainer* BoneContainerNullable) const;
 	void SimulateVerlet(const UWorld* World, float InDeltaTime, const FTransform& ComponentTransform, const FTransform& PrevComponentTransform);
+	void PrepareFrameUpdateParam(const FTransform& ComponentTransform, const FTransform& PrevComponentTransform, int32 NumSteps);
 	bool PreUpdateBones(const UWorld* World, float InDeltaTime, const FTransform& ComponentTransform, const FTransform& PrevComponentTransform);
 	void UpdateBroadphase(const UWorld* World, float InDeltaTime, const FTransform& ComponentTransform);
+	void UpdateWorldGeometryCache();
+	void UpdateWorldGroundPlane(const UWorld* World, const class USkeletalMeshComponent* SkeletalMeshComponent);
+	void UpdateSignificance_GameThread(const class USkeletalMeshComponent* SkeletalMeshComponent);
+	float CalculateScreenSizeSignificance_GameThread(const class USkeletalMeshComponent* SkeletalMeshComponent) const;
+	void UpdateSignificanceLOD();
+	void UpdateBudget_GameThread(const class USkeletalMeshComponent* SkeletalMeshComponent);
+	void ApplyBudgetDecision();
+	void UpdateOffscreen_GameThread(const class USkeletalMeshComponent* SkeletalMeshComponent);
+	void ApplyOffscreenThrottle();
+	bool ShouldHoldSimulation() const;
+	void UpdateWindComponentCache_GameThread(const class USkeletalMeshComponent* SkeletalMeshComponent);
+	FVector SampleCachedWindVelocity(const TArray<FVector, TInlineAllocator<8>>& InWindVelocities, const FVector& InLocation) const;
 	void SolveConstraints(float InDeltaTime);
 	void ApplyComponentInertiaTangentialDamping(float InDeltaTime);
-	void UpdateSleep(float InDeltaTime);
+	void UpdateSleep(IN OUT struct FLKAnimVerletBone& CurVerletBone, float InDeltaTime, float SleepThresholdSQ, float WakeUpThresholdSQ);
+	void BuildSleepIslands();
+	void UpdateSleepIslandsWakeUp(bool bComponentFrameMoved, float WakeUpThresholdSQ);
+	void WakeUpSleepIsland(IN OUT struct FLKAnimVerletSleepIsland& InIsland);
+	void WakeUpSleepIslandsNearMovingColliders();
+	void UpdateSleepingBoneStat(int32 NumSleepingBones);
+	int32 GetSimulateBoneIndex(const struct FLKAnimVerletBone* InBone) const;
+	inline bool IsBoneIndexInSleepingIsland(int32 BoneIndex) const { return (SimulateBoneIslandIndexes.IsValidIndex(BoneIndex) && SleepIslands[SimulateBoneIslandIndexes[BoneIndex]].bSleep); }
+	inline bool IsBoneInSleepingIsland(const struct FLKAnimVerletBone* InBone) const { return IsBoneIndexInSleepingIsland(GetSimulateBoneIndex(InBone)); }
+	inline bool IsConstraintInSleepingIsland(const FLKAnimVerletConstraint_Pin& InConstraint) const { return (NumSleepingIslands > 0 && IsBoneInSleepingIsland(InConstraint.Bone)); }
+	template <typename TConstraint>
+	inline bool IsConstraintInSleepingIsland(const TConstraint& InConstraint) const { return (NumSleepingIslands > 0 && IsBoneInSleepingIsland(InConstraint.BoneA)); }
+	inline bool AreAllIslandsAsleep() const { return (SleepIslands.Num() > 0 && NumSleepingIslands == SleepIslands.Num()); }
 	void PostUpdateBones(float InDeltaTime);
+	void UpdateExcludedBonesAndRotations();
+	void UpdateProceduralSway(float InDeltaTime, const FTransform& ComponentTransform, const FTransform& PrevComponentTransform);
 	void ApplyResult(OUT TArray<FBoneTransform>& OutBoneTransforms, FComponentSpacePoseContext& PoseContext, const FBoneContainer& BoneContainer);
+	void BuildSleepingResultCache(const TArray<FBoneTransform>& InBoneTransforms, FComponentSpacePoseContext& PoseContext, const FBoneContainer& BoneContainer);
+	bool ApplySleepingResultCache(OUT TArray<FBoneTransform>& OutBoneTransforms, FComponentSpacePoseContext& PoseContext, const FBoneContainer& BoneContainer, const FTransform& ComponentTransform);
+	bool IsCachedPoseValid(const FLKAnimVerletCachedBoneResult& InCachedResult, FComponentSpacePoseContext& PoseContext) const;
+	uint32 CalculateShareSettingsHash() const;
+	uint32 MakeShareKey(FComponentSpacePoseContext& PoseContext, int32 LODLevel, const UWorld* World) const;
+	void PublishSharedResult(const TArray<FBoneTransform>& InBoneTransforms, FComponentSpacePoseContext& PoseContext);
+	bool ApplySharedResult(OUT TArray<FBoneTransform>& OutBoneTransforms, FComponentSpacePoseContext& PoseContext, const FBoneContainer& BoneContainer);
 	void ResetOutputBlend();
+	void BeginOutputBlendFromCurrentResult();
 	void AdvanceOutputBlend(float InDeltaTime);
 	void ClearSimulateBones();
+	void ClearSimulationTopology();
+	void ResetTopologyTransientState();
 	void ResetSimulation();
 
 	template <typename Predicate>
@@ -91,7 +191,10 @@ public:
 	const TArray<FLKAnimVerletConstraint_FlatBending>& GetFlatBendingConstraints() const { return FlatBendingConstraints; }
 
 	void SetDynamicCollisionShapes(const FLKAnimVerletCollisionShapeList& InDynamicCollisionShapes) { DynamicCollisionShapes = InDynamicCollisionShapes; }
-	void ForceClearSimulateBones() { ClearSimulateBones(); }	/// for live editor preview
+	void ForceClearSimulateBones() { ClearSimulateBones(); bTopologyAssetUpToDate = false; }	/// for live editor preview(edited settings no longer match the baked topology)
+	void WakeUpSleepIslands();		/// for external impulses
+	float GetSleepingBoneFraction() const { return SleepingBoneFraction; }
+	float GetCurrentSignificance() const { return CurrentSignificance; }
 
 	bool IsSingleChain() const { return (BoneChainIndexes.Num() == 1); }
 	void ResetCollisionShapes();
@@ -103,6 +206,13 @@ public:
 	bool ConvertPhysicsAssetToDataAsset();
 	bool ConvertCollisionShapesFromPhysicsAsset();
 	void SyncFromOtherAnimVerletNode(const FLKAnimNode_AnimVerlet& Other);
+	/// Stale checks of ULKAnimVerletTopologyAsset
+	uint32 CalculateTopologySettingsHash() const;
+	static uint32 CalculateTopologySkeletonHash(const FBoneContainer& BoneContainer);
+#if WITH_EDITOR
+	/// Builds the topology on a copy of this node from the reference pose of BoneContainer
+	bool BakeTopologyAsset(OUT class ULKAnimVerletTopologyAsset& OutAsset, const FBoneContainer& BoneContainer) const;
+#endif
 
 	void ApplyPresetType(ELKAnimVerletPreset InPresetType);
 	bool IsPresetTypeRelatedProperty(const FName& InPropertyName) const;
@@ -121,6 +231,80 @@ public:
 	/** Rebuild topology, constraints, broadphase, and collisions when the required-bone LOD changes. Matching bone states are preserved. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Setup")
 	bool bRebuildSimulationOnLODChange = false;
+	/** Keep the simulation built for each LOD. Returning to a visited LOD swaps it back in instead of walking the skeleton and rebuilding every constraint. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Setup")
+	bool bCacheSimulationPerLOD = true;
+	/** 
+		How the simulation is built when the node starts. 
+		TimeSliced and Async spread the cost of spawning many characters at once. The pose passes through until the simulation is ready. 
+		Async measures rest lengths and angles on the reference pose instead of the first evaluated pose.
+	*/
+	UPROPERTY(EditAnywhere, Category = "Setup")
+	ELKAnimVerletInitializationMode InitializationMode = ELKAnimVerletInitializationMode::Immediate;
+	/** 
+		Topology baked in the editor("Bake Topology Asset"). The node copies it instead of walking the skeleton and building every constraint. 
+		A topology baked with other settings or another skeleton is ignored and the node builds it by InitializationMode.
+	*/
+	UPROPERTY(EditAnywhere, Category = "Setup")
+	class ULKAnimVerletTopologyAsset* TopologyAsset = nullptr;
+	/** 
+		Scale SolveIteration, MaxSubStep, the update rate and self collision by significance(0~1). 
+		SolveIteration and MaxSubStep are lerped from 1 at significance 0 to their values at significance 1, then clamped by the matching tier.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD")
+	bool bUseSignificanceLOD = false;
+	/** Externally computed significance(e.g. from USignificanceManager). A negative value uses the built-in screen size metric. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD", meta = (PinHiddenByDefault, EditCondition = "bUseSignificanceLOD", ClampMax = "1.0"))
+	float SignificanceOverride = -1.0f;
+	/** Built-in metric: bounds radius / distance to the closest view at which the significance becomes 1. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD", meta = (EditCondition = "bUseSignificanceLOD", ClampMin = "0.001"))
+	float SignificanceFullScreenSize = 0.1f;
+	/** The tier with the highest MinSignificance not above the current significance is used. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD", meta = (EditCondition = "bUseSignificanceLOD"))
+	TArray<FLKAnimVerletSignificanceTier> SignificanceTiers = { FLKAnimVerletSignificanceTier(0.5f, 4, 3, 1, true), FLKAnimVerletSignificanceTier(0.2f, 2, 2, 2, false), FLKAnimVerletSignificanceTier(0.0f, 1, 1, 4, false) };
+	/**
+		Per mesh LOD feature overrides. The entry with the highest MinLOD not above the current LOD is used.
+		Disabled features are skipped while solving, so switching LOD does not rebuild their constraints.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD")
+	TArray<FLKAnimVerletLODFeatureSetting> LODFeatureOverrides;
+	/** Register to the global frame budget scheduler(a.AnimNode.AnimVerlet.BudgetMs). Over budget, the lowest priority nodes are time sliced, then reduced, then frozen. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD")
+	bool bUseBudgetScheduler = true;
+	/** Gameplay importance for the budget scheduler. Scaled by the screen size significance and visibility. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD", meta = (PinHiddenByDefault, EditCondition = "bUseBudgetScheduler", ClampMin = "0.0"))
+	float BudgetPriority = 1.0f;
+	/** What to do while the mesh has not been rendered for OffscreenTime. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD")
+	ELKAnimVerletOffscreenMode OffscreenMode = ELKAnimVerletOffscreenMode::Simulate;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD", meta = (EditCondition = "OffscreenMode != ELKAnimVerletOffscreenMode::Simulate", ClampMin = "0.0", ForceUnits = "s"))
+	float OffscreenTime = 0.2f;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD", meta = (EditCondition = "OffscreenMode == ELKAnimVerletOffscreenMode::Throttle", EditConditionHides, ClampMin = "1"))
+	int32 OffscreenUpdateInterval = 8;
+	/** Reset to the current pose(and warm up if bUseWarmup) when the mesh becomes visible again, instead of continuing from the held state. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD", meta = (EditCondition = "OffscreenMode != ELKAnimVerletOffscreenMode::Simulate"))
+	bool bResetWhenBecomeVisible = false;
+	/** Throttle: the largest part of the time accumulated offscreen that is simulated on the first visible update. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD", meta = (EditCondition = "OffscreenMode == ELKAnimVerletOffscreenMode::Throttle && bResetWhenBecomeVisible == false", EditConditionHides, ClampMin = "0.0", ForceUnits = "s"))
+	float OffscreenMaxCatchUpTime = 0.1f;
+	/** 
+		Share the simulation result with identical instances(crowds). Nodes with the same mesh, settings and animation phase form a group.
+		One leader simulates and the followers apply its result relative to their own pose.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sharing")
+	bool bShareSimulationResult = false;
+	/** Only nodes with the same name share. Use it to separate instances that must not share. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sharing", meta = (EditCondition = "bShareSimulationResult"))
+	FName ShareGroupName = NAME_None;
+	/** Instances whose dominant animation phase falls into the same bucket share. 0 ignores the animation. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sharing", meta = (EditCondition = "bShareSimulationResult", ClampMin = "0.0", ForceUnits = "s"))
+	float ShareTimeBucket = 0.25f;
+	/** Followers apply the leader`s result from this many frames ago to break up identical motion. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sharing", meta = (EditCondition = "bShareSimulationResult", ClampMin = "0", ClampMax = "8"))
+	int32 SharePhaseOffsetFrames = 0;
+	/** Pick a per instance phase offset between 0 and SharePhaseOffsetFrames. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sharing", meta = (EditCondition = "bShareSimulationResult"))
+	bool bRandomizeSharePhaseOffset = true;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Setup", meta = (PinShownByDefault))
 	bool bActivate = true;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Setup")
@@ -215,6 +399,24 @@ public:
 	float SleepTriggerDuration = 5.0f;
 	UPROPERTY(EditAnywhere, Category = "Solve", meta = (EditCondition = "bUseSleep", ClampMin = "0.0", ForceUnits = "cm"))
 	float WakeUpDeltaThreshold = 0.1f;
+	/** 
+		Put a whole connected island(a chain or a cloth patch) to sleep once all of its bones sleep. 
+		A sleeping island is skipped by the bone update, every bone to bone constraint and the broadphase until
+		its animation pose or component acceleration moves a bone more than WakeUpDeltaThreshold, or an external force changes.
+	*/
+	UPROPERTY(EditAnywhere, Category = "Solve", meta = (EditCondition = "bUseSleep"))
+	bool bUseIslandSleep = false;
+	/** A moving sphere, capsule or box collider wakes a sleeping island when its swept bound comes within this margin of the island bound */
+	UPROPERTY(EditAnywhere, Category = "Solve", meta = (EditCondition = "bUseSleep && bUseIslandSleep", ClampMin = "0.0", ForceUnits = "cm"))
+	float SleepIslandColliderWakeMargin = 2.0f;
+	/** 
+		Once every bone sleeps, the last result is stored as offsets relative to the animation pose and reapplied without simulating.
+		The full simulation resumes when the component moves, a force changes or a simulated/collider bone pose changes beyond the tolerances.
+	*/
+	UPROPERTY(EditAnywhere, Category = "Solve", meta = (EditCondition = "bUseSleep"))
+	bool bUseSleepingResultCache = false;
+	UPROPERTY(EditAnywhere, Category = "Solve", meta = (EditCondition = "bUseSleep && bUseSleepingResultCache", ClampMin = "0.0", ForceUnits = "deg"))
+	float SleepingResultCacheRotationTolerance = 0.5f;
 
 	/** Adjust distance constraint to diagonal directions. (This is helpful when using the bIgnoreAnimationPose option) */
 	UPROPERTY(EditAnywhere, AdvancedDisplay, Category = "Solve")
@@ -390,6 +592,67 @@ public:
 	FName WorldCollisionProfile = NAME_None;
 	UPROPERTY(EditAnywhere, Category = "Collision", meta = (PinHiddenByDefault))
 	TArray<FBoneReference> WorldCollisionExcludeBones;
+	/** 
+		Queue world sweeps as async traces on the game thread instead of sweeping in anim evaluation.
+		Hits are used as contact planes in the next frame.(One frame latency, removes scene queries from the anim worker)
+	*/
+	UPROPERTY(EditAnywhere, Category = "Collision", meta = (PinHiddenByDefault))
+	bool bUseAsyncWorldCollision = false;
+	/** 
+		Replace per bone world sweeps with one overlap query per frame around the chain.
+		Simple collision(sphere, capsule, box, convex) of overlapped primitives is cached and solved in every iteration like local collision shapes.
+		Primitives without simple collision(heightfield, complex mesh) still fall back to sweeps. Takes priority over bUseAsyncWorldCollision.
+	*/
+	UPROPERTY(EditAnywhere, Category = "Collision", meta = (PinHiddenByDefault))
+	bool bUseWorldGeometryCache = false;
+	/** Extra distance around the swept chain bound used for the geometry cache overlap query. */
+	UPROPERTY(EditAnywhere, Category = "Collision", meta = (EditCondition = "bUseWorldGeometryCache", ClampMin = "0.0", ForceUnits = "cm"))
+	float WorldGeometryCacheMargin = 10.0f;
+	/** 
+		Reuse the last world hit plane of each bone without a sweep while the bone stays near the plane and barely moves.
+		(Helps bones resting on the ground or against a wall. Not used by the async and geometry cache modes.)
+	*/
+	UPROPERTY(EditAnywhere, Category = "Collision", meta = (PinHiddenByDefault))
+	bool bUseWorldCollisionContactCache = false;
+	/** Max distance between the bone surface and its cached contact plane to keep using the plane. */
+	UPROPERTY(EditAnywhere, Category = "Collision", meta = (EditCondition = "bUseWorldCollisionContactCache", ClampMin = "0.0", ForceUnits = "cm"))
+	float WorldCollisionContactCacheDistance = 1.0f;
+	/** Max world space movement of the bone during one step to keep using the cached contact plane. */
+	UPROPERTY(EditAnywhere, Category = "Collision", meta = (EditCondition = "bUseWorldCollisionContactCache", ClampMin = "0.0", ForceUnits = "cm"))
+	float WorldCollisionContactCacheMotionThreshold = 0.5f;
+	/** Bones that barely move(in world space, sleeping bones included) reuse the result of their last world sweep without a new sweep. */
+	UPROPERTY(EditAnywhere, Category = "Collision", meta = (PinHiddenByDefault))
+	bool bSkipWorldCollisionForStationaryBones = false;
+	/** World space movement during one step below which a bone is considered stationary.(Component movement included) */
+	UPROPERTY(EditAnywhere, Category = "Collision", meta = (EditCondition = "bSkipWorldCollisionForStationaryBones", ClampMin = "0.0", ForceUnits = "cm"))
+	float WorldCollisionStationaryThreshold = 0.01f;
+	/** 
+		Test the whole chain with one coarse overlap before sweeping each bone. If nothing is found, every sweep is skipped
+		until the chain moves out of the tested bound inflated by WorldCollisionEarlyOutMargin.
+		(World objects that move into that bound while the result is cached are not detected)
+	*/
+	UPROPERTY(EditAnywhere, Category = "Collision", meta = (PinHiddenByDefault))
+	bool bUseWorldCollisionEarlyOut = false;
+	UPROPERTY(EditAnywhere, Category = "Collision", meta = (EditCondition = "bUseWorldCollisionEarlyOut", ClampMin = "0.0", ForceUnits = "cm"))
+	float WorldCollisionEarlyOutMargin = 20.0f;
+	/** 
+		Replace per bone world sweeps with one downward line trace per frame from the component.
+		The hit becomes an infinite plane solved like PlaneCollisionShapes.(For skirts, coats or tails touching the floor)
+	*/
+	UPROPERTY(EditAnywhere, Category = "Collision", meta = (PinHiddenByDefault))
+	bool bUseWorldGroundPlane = false;
+	/** The trace starts this far above the component location. */
+	UPROPERTY(EditAnywhere, Category = "Collision", meta = (EditCondition = "bUseWorldGroundPlane", ClampMin = "0.0", ForceUnits = "cm"))
+	float WorldGroundPlaneTraceStartHeight = 50.0f;
+	/** The trace ends this far below the component location. */
+	UPROPERTY(EditAnywhere, Category = "Collision", meta = (EditCondition = "bUseWorldGroundPlane", ClampMin = "0.0", ForceUnits = "cm"))
+	float WorldGroundPlaneTraceDepth = 100.0f;
+	/** The plane is replaced only when the new hit is farther than this from the current plane. */
+	UPROPERTY(EditAnywhere, Category = "Collision", meta = (EditCondition = "bUseWorldGroundPlane", ClampMin = "0.0", ForceUnits = "cm"))
+	float WorldGroundPlaneUpdateDistance = 0.5f;
+	/** The plane is replaced only when the new hit normal differs more than this. */
+	UPROPERTY(EditAnywhere, Category = "Collision", meta = (EditCondition = "bUseWorldGroundPlane", ClampMin = "0.0", ForceUnits = "deg"))
+	float WorldGroundPlaneUpdateAngle = 2.0f;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Collision", meta = (PinHiddenByDefault))
 	TArray<FLKAnimVerletCollisionSphere> SphereCollisionShapes;
@@ -446,12 +709,29 @@ public:
 	bool bRandomWindDirectionInWorldSpace = true;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wind", meta = (PinHiddenByDefault))
 	TArray<FLKAnimVerletRandomForceSetting> AdditionalRandomWinds;
+	/** 
+		Random wind sizes come from a coherent noise field over the pose location and simulated time instead of a per bone random number.
+		Lower frequency makes neighbouring bones move together. Results are reproducible for the same seed and delta times.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wind", meta = (PinHiddenByDefault, ClampMin = "0.0"))
+	float RandomWindNoiseFrequency = 0.02f;
+	/** How fast the noise field changes over time. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wind", meta = (PinHiddenByDefault, ClampMin = "0.0"))
+	float RandomWindNoiseSpeed = 4.0f;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wind", meta = (PinHiddenByDefault))
+	int32 RandomWindSeed = 0;
 
 	/** Adjust UWindDirectionalSourceComponent in world. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wind", meta = (PinHiddenByDefault))
 	bool bAdjustWindComponent = false;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wind", meta = (PinHiddenByDefault, EditCondition = "bAdjustWindComponent"))
 	float WindComponentScale = 1.0f;
+	/** 
+		Number of points the scene wind is sampled at on the game thread once per frame. 
+		Points are spread along the longest axis of the simulated pose and interpolated per bone.
+	*/
+	UPROPERTY(EditAnywhere, Category = "Wind", meta = (PinHiddenByDefault, EditCondition = "bAdjustWindComponent", ClampMin = "1", ClampMax = "8"))
+	int32 WindComponentSampleCount = 2;
 
 	/** The scale to be applied to the inertia caused by the component's positional movement in the world. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inertia", meta = (PinHiddenByDefault, ClampMin = "0.0"))
@@ -484,6 +764,12 @@ public:
 	/** Fraction of parent-relative tangential velocity retained while component inertia is being applied. 1 keeps all velocity; 0 removes it. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inertia", meta = (PinHiddenByDefault, ClampMin = "0.0", ClampMax = "1.0"))
 	float ComponentInertiaTangentialDamping = 1.0f;
+	/** 
+		Apply component inertia as a displacement from the component`s acceleration instead of rebasing every bone into the moved component frame.
+		Constant component motion then needs no per bone work and does not wake sleeping bones. Damping acts relative to the component.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inertia", meta = (PinHiddenByDefault))
+	bool bSimulateInInertialFrame = false;
 
 private:
 	TArray<FLKAnimVerletBone> SimulateBones;										///Simulating bones(real bones + fake virtual bones)
@@ -514,16 +800,75 @@ private:
 	TArray<TArray<int32>> BoneChainIndexes;									///Simulating bone`s index list per single chain
 	int32 MaxBoneChainLength = 0;
 	float MaxThickness = 0.0f;
+	TExcludeBoneBits WorldCollisionExcludeBoneBits;
+	FLKAnimVerletWorldContactPlane WorldGroundPlane;						///Ground plane proxy(world space)
+	TArray<FLKAnimVerletSleepIsland> SleepIslands;							///Connected bone islands for bUseIslandSleep
+	TArray<int32> SimulateBoneIslandIndexes;								///SleepIslands index per simulating bone
+	int32 NumSleepingIslands = 0;
+	float SleepingBoneFraction = 0.0f;
+	TArray<FLKAnimVerletBound> PrevColliderBounds;							///Local collider bounds of the last frame(component space)
+	TArray<FLKAnimVerletBound> CurColliderBounds;
+	TArray<FLKAnimVerletCachedBoneResult> SleepingResultCache;				///Sorted by BonePoseIndex like the output
+	TArray<FLKAnimVerletCachedBoneResult> SleepingResultColliderPoses;		///Poses of bones carrying local colliders
+	FVector SleepingResultCacheGravity = FVector::ZeroVector;
+	FVector SleepingResultCacheExternalForce = FVector::ZeroVector;
+	bool bHasSleepingResultCache = false;
+	TArray<FVector, TInlineAllocator<8>> CachedWindVelocities;				///UWindDirectionalSourceComponent velocity per sample point(world space, sampled on game thread)
+	FVector CachedWindSampleStart = FVector::ZeroVector;					///Component space
+	FVector CachedWindSampleEnd = FVector::ZeroVector;						///Component space
+	float RandomWindNoiseTime = 0.0f;										///Simulated time of the random wind noise field
+	FLKAnimVerletFrameUpdateParam FrameUpdateParam;							///Prepared once per frame, shared by every substep
+	FVector PrevInertialMoveDiff = FVector::ZeroVector;					///Last substep`s component move delta(bSimulateInInertialFrame)
+	FVector PrevInertialRotVector = FVector::ZeroVector;					///Last substep`s component rotation delta as a rotation vector(bSimulateInInertialFrame)
+	bool bHasPrevInertialDiff = false;										///false: the next substep seeds PrevInertialMoveDiff/PrevInertialRotVector instead of applying them
+	TArray<FLKAnimVerletSwayState> SwayStates;								///Procedural sway state per simulating bone
+	TArray<FTransform> OutputBlendSourceOffsets;							///Result of the previous mode relative to the pose per RelevantBoneIndicators(empty : blend from the pose)
+	TMap<uint32, FLKAnimVerletSimulationTopology> LODTopologyCache;			///Parked topologies of previously simulated LODs(bCacheSimulationPerLOD)
+	uint32 ActiveLODTopologyKey = 0;
+	TSharedPtr<FLKAnimNode_AnimVerlet, ESPMode::ThreadSafe> AsyncTopologyBuilder;	///Node with the build inputs of this node that builds the topology off-thread(ELKAnimVerletInitializationMode::Async)
+	UE::Tasks::FTask AsyncTopologyTask;
 
 private:
 	bool bLocalColliderDirty = false;
 	bool bPendingSimulationLODRebuild = false;
 	bool bPendingDynamicsReset = false;
 	bool bWarmupPending = false;
+	bool bTopologyAssetUpToDate = false;
 	int32 CachedSimulationLOD = INDEX_NONE;
 	float DeltaTime = 0.0f;
 	float FixedStepAccumulator = 0.0f;
 	int32 NumPendingSimulationSteps = 0;
 	float OutputBlendAlpha = 0.0f;
 	FTransform PrevComponentT = FTransform::Identity;
+
+	float MeasuredSignificance = 1.0f;										///Built-in metric(written on game thread)
+	float CurrentSignificance = 1.0f;
+	int32 EffectiveSolveIteration = 4;
+	int32 EffectiveMaxSubStep = 3;
+	int32 UpdateFrameInterval = 1;
+	bool bSignificanceAllowSelfCollision = true;
+	int32 SkippedUpdateFrames = 0;
+	float SkippedUpdateDeltaTime = 0.0f;
+
+	int32 BudgetHandle = INDEX_NONE;
+	ELKAnimVerletBudgetDecision BudgetDecision = ELKAnimVerletBudgetDecision::Full;		///Written on game thread
+
+	bool bOffscreen = false;												///Written on game thread
+	bool bSimulatedOffscreen = false;
+
+	int32 LODMaxSolveIteration = 0;											///0 : no limit
+	bool bLODAllowSelfCollision = true;
+	bool bLODAllowWorldCollision = true;
+	bool bLODAllowBendingConstraints = true;
+	bool bLODAllowConeAngleConstraints = true;
+	bool bLODAllowCapsuleCollisionForChain = true;
+	int32 LODChainResolutionStride = 1;
+	bool bLODUseProceduralSway = false;
+	bool bProceduralSwayActive = false;
+	bool bProceduralSwayStateValid = false;
+
+	int32 ShareHandle = INDEX_NONE;
+	bool bShareLeader = true;
+	uint32 ShareSettingsHash = 0;
+	TArray<FLKAnimVerletCachedBoneResult> SharedResult;						///Published or applied share group result
 };
\ No newline at end of file
@@ -93,7 +93,7 @@ public:
 	void SetFakeBoneOffset(const FVector& InLocationOffset);
 	void SetSideStraightenDirInLocal(const FVector& InDir) { SideStraightenDirInLocal = InDir; }
 	void PrepareSimulation(const FTransform& PoseT, const FVector& InPoseDirFromParent);
-	void Update(float DeltaTime, const struct FLKAnimVerletUpdateParam& InParam);
+	void Update(float DeltaTime, const struct FLKAnimVerletUpdateParam& InParam, bool bApplyComponentFrameMotion = true);
 	void PostUpdate(float DeltaTime);
 	void AdjustPoseTransform(float DeltaTime, const FVector& ParentLocation, const FVector& ParentPoseLocation, const FVector& ParentGravityAlignedPoseLocation,
 							 bool bAlignAnimationPoseToGravity, float AnimationPoseInertia, float AnimationPoseDeltaInertia, bool bClampAnimationPoseDeltaInertia, float AnimationPoseDeltaInertiaClampMax);
@@ -117,6 +117,11 @@ public:
 	float LengthToParent = 0.0f;
 	bool bStraightenExcludedBonesByParent = true;
 
+	/// Skipped by a reduced chain resolution. Interpolated between the simulated parent and child by pose length.
+	bool bChainResolutionSkipped = false;
+	int32 InterpolationChildVerletBoneIndex = INDEX_NONE;
+	float InterpolationAlpha = 0.0f;
+
 public:
 	FLKAnimVerletExcludedBone() = default;
 	FLKAnimVerletExcludedBone(const FBoneReference& InBoneReference, int32 InParentVerletBoneIndex, int32 InParentExcludedBoneIndex)
@@ -128,6 +133,7 @@ public:
 	bool HasParentBone() const { return HasVerletParentBone() || HasExcludedParentBone(); }
 	bool HasVerletParentBone() const { return ParentVerletBoneIndex != INDEX_NONE; }
 	bool HasExcludedParentBone() const { return ParentExcludedBoneIndex != INDEX_NONE; }
+	bool IsInterpolated() const { return InterpolationChildVerletBoneIndex != INDEX_NONE; }
 
 public:
 	void PrepareSimulation(const FTransform& PoseT);
@@ -239,4 +245,44 @@ public:
 public:
 	const FBoneReference& BoneReference;
 };
+///=========================================================================================================================================
+
+
+///=========================================================================================================================================
+/// FLKAnimVerletSleepIsland
+///=========================================================================================================================================
+struct FLKAnimVerletSleepIsland
+{
+public:
+	TArray<int32> BoneIndexes;		///Simulating bones connected through the parent hierarchy or any bone to bone constraint
+	FLKAnimVerletBound Bound;		///Component space bound while sleeping(for collider proximity wake up)
+	int32 NumAwakeBones = 0;
+	bool bSleep = false;
+};
+///=========================================================================================================================================
+
+
+///=========================================================================================================================================
+/// FLKAnimVerletCachedBoneResult
+///=========================================================================================================================================
+struct FLKAnimVerletCachedBoneResult
+{
+public:
+	FCompactPoseBoneIndex BonePoseIndex = FCompactPoseBoneIndex(INDEX_NONE);
+	FTransform PoseOffset = FTransform::Identity;	///Result relative to the pose(component space)
+	FTransform PoseT = FTransform::Identity;		///Pose when the result was cached(component space)
+};
+///=========================================================================================================================================
+
+
+///=========================================================================================================================================
+/// FLKAnimVerletSwayState
+///=========================================================================================================================================
+struct FLKAnimVerletSwayState
+{
+public:
+	FVector Offset = FVector::ZeroVector;					///Spring displacement from the parent relative pose(component space)
+	FVector Velocity = FVector::ZeroVector;					///Component space
+	FVector PrevInertialVelocity = FVector::ZeroVector;		///Pose point velocity caused by the component movement(world space)
+};
 ///=========================================================================================================================================
\ No newline at end of file
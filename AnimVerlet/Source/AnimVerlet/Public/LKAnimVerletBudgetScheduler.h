@@ -0,0 +1,61 @@
+#pragma once
+#include <CoreMinimal.h>
+#include <HAL/CriticalSection.h>
+
+/// Escalation order when the frame budget is exceeded. Each level includes the previous ones.
+enum class ELKAnimVerletBudgetDecision : uint8
+{
+	Full,
+	TimeSliced,
+	ReducedIteration,
+	Frozen,
+};
+
+///=========================================================================================================================================
+/// LKAnimVerletBudgetScheduler
+/// Global registry of active AnimVerlet nodes sharing one CPU budget per frame(a.AnimNode.AnimVerlet.BudgetMs).
+/// Nodes register their priority on the game thread and report the measured simulation cost from the worker.
+/// Once per frame the lowest priority nodes are demoted until the estimated cost fits into the budget.
+/// Nodes with ELKAnimVerletInitializationMode::TimeSliced also share a per-frame quota of simulation builds here.
+///=========================================================================================================================================
+class LKAnimVerletBudgetScheduler
+{
+public:
+	static constexpr int32 TimeSliceInterval = 2;
+	static constexpr int32 ReducedSolveIteration = 1;
+
+public:
+	static LKAnimVerletBudgetScheduler& Get();
+	static bool IsEnabled();
+	static const TCHAR* GetDecisionName(ELKAnimVerletBudgetDecision InDecision);
+
+	/// Game thread. Returns the decision made for the current frame.
+	ELKAnimVerletBudgetDecision UpdateEntry(IN OUT int32& InOutHandle, float InPriority);
+	/// Any thread. Cost of one simulated frame in milliseconds.
+	void ReportCost(int32 InHandle, float InCostMs, ELKAnimVerletBudgetDecision InDecision);
+	/// Any thread. Whether a TimeSliced node may build its simulation on this frame(a.AnimNode.AnimVerlet.MaxInitializationsPerFrame).
+	bool TryAcquireInitialization();
+
+private:
+	struct FLKBudgetEntry
+	{
+		float Priority = 1.0f;
+		float FullCostMs = 0.0f;
+		uint64 LastUpdateFrame = 0;
+		ELKAnimVerletBudgetDecision Decision = ELKAnimVerletBudgetDecision::Full;
+	};
+
+	void Rebalance(float BudgetMs);
+	static float EstimateFrameCost(const FLKBudgetEntry& InEntry, ELKAnimVerletBudgetDecision InDecision);
+
+private:
+	FCriticalSection EntriesLock;
+	TMap<int32, FLKBudgetEntry> Entries;
+	int32 NextHandle = 0;
+	uint64 LastRebalanceFrame = MAX_uint64;
+	int32 PrevNumDemoted[3] = { 0, 0, 0 };										///Last bookmarked decisions
+
+	FCriticalSection InitializationLock;
+	uint64 LastInitializationFrame = MAX_uint64;
+	int32 NumInitializationsThisFrame = 0;
+};
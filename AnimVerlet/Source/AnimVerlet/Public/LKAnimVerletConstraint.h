@@ -28,6 +28,7 @@ public:
 	float PinMargin = 0.0f;
 
 public:
+	FLKAnimVerletConstraint_Pin() = default;		/// for baked topologies(ULKAnimVerletTopologyAsset)
 	FLKAnimVerletConstraint_Pin(struct FLKAnimVerletBone* InBone, float InPinMargin = 0.0f) 
 		: Bone(InBone), PinMargin(InPinMargin) 
 	{ 
@@ -61,6 +62,7 @@ public:
 	int8 ActiveDistanceRange = 0;				///-1: minimum, 0: inactive, 1: maximum
 
 public:
+	FLKAnimVerletConstraint_Distance() = default;
 	FLKAnimVerletConstraint_Distance(struct FLKAnimVerletBone* InBoneA, struct FLKAnimVerletBone* InBoneB, bool bInUseXPBDSolver, 
 									 double InStiffness, bool bInStretchEachBone, float InStretchStrength);
 	FLKAnimVerletConstraint_Distance(struct FLKAnimVerletBone* InBoneA, struct FLKAnimVerletBone* InBoneB, bool bInUseXPBDSolver,
@@ -95,6 +97,7 @@ public:
 	float MaxAngleRadians = PI;
 
 public:
+	FLKAnimVerletConstraint_IsometricBending() = default;
 	/// [Edge B-C is shared]
 	///	A---B
 	///	\  | \
@@ -134,6 +137,7 @@ public:
 	float MaxAngleRadians = PI;
 
 public:
+	FLKAnimVerletConstraint_Bending_1D() = default;
 	FLKAnimVerletConstraint_Bending_1D(struct FLKAnimVerletBone* InBoneA, struct FLKAnimVerletBone* InBoneB, struct FLKAnimVerletBone* InBoneC,
 									  bool bInUseXPBDSolver, double InStiffness, double InMinCompliance = -1.0,
 									  float InMaxStiffness = -1.0f, float InMaxAngleRadians = PI);
@@ -170,6 +174,7 @@ public:
 	float FlatAlpha = 0.0f;
 
 public:
+	FLKAnimVerletConstraint_FlatBending() = default;
 	/// [Edge B-C is shared]
 	///	A---B
 	///	\  | \
@@ -204,6 +209,7 @@ public:
 	bool bStraightenCenterBone = false;
 
 public:
+	FLKAnimVerletConstraint_Straighten() = default;
 	FLKAnimVerletConstraint_Straighten(struct FLKAnimVerletBone* InBoneA, struct FLKAnimVerletBone* InBoneB, struct FLKAnimVerletBone* InBoneC, 
 									   float InStraightenStrength, bool bInStraightenCenterBone);
 	virtual void Update(float DeltaTime, bool bInitialUpdate, bool bFinalize) override;
@@ -228,6 +234,7 @@ public:
 	float LengthMargin = 0.0f;
 
 public:
+	FLKAnimVerletConstraint_FixedDistance() = default;
 	FLKAnimVerletConstraint_FixedDistance(struct FLKAnimVerletBone* InBoneA, struct FLKAnimVerletBone* InBoneB, bool bInStretchEachBone, 
 										  float InStretchStrength, bool bInAwayFromEachOther, float InLengthMargin = 0.0f);
 	virtual void Update(float DeltaTime, bool bInitialUpdate, bool bFinalize) override;
@@ -257,6 +264,7 @@ public:
 	double Lambda = 0.0;			///for XPBD
 
 public:
+	FLKAnimVerletConstraint_BallSocket() = default;
 	FLKAnimVerletConstraint_BallSocket(struct FLKAnimVerletBone* InBoneA, struct FLKAnimVerletBone* InBoneB, struct FLKAnimVerletBone* InGrandParentNullable, struct FLKAnimVerletBone* InParentNullable,
 									   float InAngleDegrees, const FRotator& InAngleOffset, bool bInUseXPBDSolver, double InCompliance);
 	FLKAnimVerletConstraint_BallSocket(struct FLKAnimVerletBone* InBoneA, struct FLKAnimVerletBone* InBoneB, struct FLKAnimVerletBone* InGrandParentNullable, struct FLKAnimVerletBone* InParentNullable,
@@ -21,3 +21,21 @@ public:
 	double Compliance = 0.0;
 	float FrictionCoefficient = 0.0f;
 };
+
+struct FLKAnimVerletWorldCollisionConstraintInput
+{
+public:
+	bool bUseAsyncQuery = false;
+	bool bUseGeometryCache = false;
+	float GeometryCacheMargin = 0.0f;
+
+	bool bUseContactCache = false;
+	float ContactCacheDistance = 0.0f;
+	float ContactCacheMotionThreshold = 0.0f;
+
+	bool bUseChainEarlyOut = false;
+	float ChainEarlyOutMargin = 0.0f;
+
+	bool bSkipStationaryBones = false;
+	float StationaryThreshold = 0.0f;
+};
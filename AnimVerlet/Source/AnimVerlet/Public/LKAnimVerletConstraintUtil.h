@@ -503,4 +503,41 @@ namespace LKAnimVerletUtil
 		OutOverlap = Overlap;
 		return (Overlap >= 0.0f);
 	}
+
+	/// Integer lattice hash for value noise. No global state, so results are reproducible and safe on any worker thread
+	inline uint32 HashNoiseLattice(int32 X, int32 Y, int32 Z, uint32 Seed)
+	{
+		uint32 Hash = Seed ^ (static_cast<uint32>(X) * 0x8da6b343u) ^ (static_cast<uint32>(Y) * 0xd8163841u) ^ (static_cast<uint32>(Z) * 0xcb1ab31fu);
+		Hash ^= Hash >> 16;
+		Hash *= 0x7feb352du;
+		Hash ^= Hash >> 15;
+		Hash *= 0x846ca68bu;
+		Hash ^= Hash >> 16;
+		return Hash;
+	}
+
+	inline float NoiseLatticeValue(int32 X, int32 Y, int32 Z, uint32 Seed)
+	{
+		return static_cast<float>(HashNoiseLattice(X, Y, Z, Seed) & 0x00ffffffu) / static_cast<float>(0x00ffffffu);
+	}
+
+	/// Smooth 3D value noise in [0, 1]
+	inline float ValueNoise3D(const FVector& P, uint32 Seed)
+	{
+		const FVector Cell(FMath::Floor(P.X), FMath::Floor(P.Y), FMath::Floor(P.Z));
+		const int32 X = static_cast<int32>(Cell.X);
+		const int32 Y = static_cast<int32>(Cell.Y);
+		const int32 Z = static_cast<int32>(Cell.Z);
+
+		const FVector Frac = P - Cell;
+		const float U = static_cast<float>(Frac.X * Frac.X * (3.0 - 2.0 * Frac.X));
+		const float V = static_cast<float>(Frac.Y * Frac.Y * (3.0 - 2.0 * Frac.Y));
+		const float W = static_cast<float>(Frac.Z * Frac.Z * (3.0 - 2.0 * Frac.Z));
+
+		const float X00 = FMath::Lerp(NoiseLatticeValue(X, Y, Z, Seed), NoiseLatticeValue(X + 1, Y, Z, Seed), U);
+		const float X10 = FMath::Lerp(NoiseLatticeValue(X, Y + 1, Z, Seed), NoiseLatticeValue(X + 1, Y + 1, Z, Seed), U);
+		const float X01 = FMath::Lerp(NoiseLatticeValue(X, Y, Z + 1, Seed), NoiseLatticeValue(X + 1, Y, Z + 1, Seed), U);
+		const float X11 = FMath::Lerp(NoiseLatticeValue(X, Y + 1, Z + 1, Seed), NoiseLatticeValue(X + 1, Y + 1, Z + 1, Seed), U);
+		return FMath::Lerp(FMath::Lerp(X00, X10, V), FMath::Lerp(X01, X11, V), W);
+	}
 };
\ No newline at end of file
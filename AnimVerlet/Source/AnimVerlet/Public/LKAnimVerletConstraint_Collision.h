@@ -1,6 +1,7 @@
 #pragma once
 #include <CoreMinimal.h>
 #include <UObject/WeakObjectPtrTemplates.h>
+#include <WorldCollision.h>
 #include "LKAnimVerletBound.h"
 #include "LKAnimVerletBroadphaseType.h"
 #include "LKAnimVerletConstraint.h"
@@ -268,6 +269,32 @@ public:
 /// CollisionConstraint
 /// FLKAnimVerletConstraint_World
 ///=========================================================================================================================================
+struct FLKAnimVerletWorldContactPlane
+{
+public:
+	FVector Location = FVector::ZeroVector;		///world space point on the hit surface
+	FVector Normal = FVector::ZeroVector;		///world space surface normal
+	FVector QueryLocation = FVector::ZeroVector;	///world space location of the swept bone(or pair center) when the plane was found
+	bool bValid = false;
+	bool bSwept = false;						///holds the result of a sweep(a valid plane or a clear sweep)
+};
+
+/// Simple world geometry gathered by the geometry cache(world space)
+struct FLKAnimVerletWorldCachedShape
+{
+public:
+	FVector Location = FVector::ZeroVector;
+	FQuat Rotation = FQuat::Identity;
+	FVector HalfExtents = FVector::ZeroVector;	///sphere: X(radius), capsule: X(radius) Z(half height), box: XYZ
+};
+
+struct FLKAnimVerletWorldCachedConvex
+{
+public:
+	TArray<FPlane, TInlineAllocator<32>> Planes;	///outward face planes(world space)
+	TArray<FPlane, TInlineAllocator<32>> PlanesInCS;	///outward face planes(component space, refreshed every step)
+};
+
 struct ANIMVERLET_API FLKAnimVerletConstraint_World : public FLKAnimVerletConstraint
 {
 public:
@@ -281,13 +308,87 @@ public:
 	TArray<FLKAnimVerletBoneIndicatorPair>* BonePairs = nullptr;
 	float FrictionCoefficient = 0.0f;						///PBD friction
 
+	/// Async query mode: sweeps are queued on the game thread in frame N and their hits are consumed as contact planes in frame N+1
+	bool bUseAsyncQuery = false;
+	TArray<FTraceHandle> AsyncTraceHandles;					///bone index(sphere) or pair index(capsule)
+	TArray<FLKAnimVerletWorldContactPlane> AsyncContactPlanes;	///bone index(sphere) or pair index(capsule)
+	uint64 AsyncTraceIssuedFrame = 0;
+	double AsyncTraceIssuedTime = 0.0;
+
+	/// Geometry cache mode: one overlap query per frame gathers the simple collision of nearby primitives,
+	/// then the particles are collided against it by the local collision constraints in every iteration
+	bool bUseGeometryCache = false;
+	float GeometryCacheMargin = 0.0f;
+	bool bGeometryCacheNeedsSweep = false;					///overlapped primitives without simple collision(complex/heightfield) fall back to sweeps
+	TArray<FLKAnimVerletWorldCachedShape> CachedSpheres;
+	TArray<FLKAnimVerletWorldCachedShape> CachedCapsules;
+	TArray<FLKAnimVerletWorldCachedShape> CachedBoxes;
+	TArray<FLKAnimVerletWorldCachedConvex> CachedConvexes;
+
+	/// Contact cache: the last hit plane of each bone(sphere) or pair(capsule) is reused without a sweep
+	/// while the bone stays close to it and barely moves
+	bool bUseContactCache = false;
+	float ContactCacheDistance = 0.0f;
+	float ContactCacheMotionThreshold = 0.0f;
+	TArray<FLKAnimVerletWorldContactPlane> CachedContactPlanes;	///bone index(sphere) or pair index(capsule)
+	int32 ContactCacheHits = 0;
+	int32 ContactCacheLookups = 0;
+
+	/// Chain early-out: one coarse overlap of the whole chain skips every sweep while nothing is around.
+	/// A clear result is kept until the chain leaves the margin-inflated bound it was tested with.
+	bool bUseChainEarlyOut = false;
+	float ChainEarlyOutMargin = 0.0f;
+	bool bChainEarlyOutClear = false;
+	FLKAnimVerletBound ChainEarlyOutBound;					///world space
+
+	/// Stationary bones(sleeping ones included) reuse the result of their last sweep. Bones without one are swept.
+	bool bSkipStationaryBones = false;
+	float StationaryThreshold = 0.0f;
+	bool bInertialFrame = false;							///bones are not rebased into the moved component frame(set by the node every frame)
+	FTransform PrevSweepComponentTransform = FTransform::Identity;
+	bool bHasPrevSweepComponentTransform = false;
+	int32 NumSkippedSweeps = 0;
+
 public:
-	FLKAnimVerletConstraint_World(const class UWorld* InWorld, class UPrimitiveComponent* InSelfComponent, const FName& InCollisionProfileName, const FLKAnimVerletCollisionConstraintInput& InCollisionInput);
+	FLKAnimVerletConstraint_World(const class UWorld* InWorld, class UPrimitiveComponent* InSelfComponent, const FName& InCollisionProfileName, const FLKAnimVerletCollisionConstraintInput& InCollisionInput, 
+								  const FLKAnimVerletWorldCollisionConstraintInput& InWorldCollisionInput);
 	virtual void Update(float DeltaTime, bool bInitialUpdate, bool bFinalize) override;
 	virtual void PostUpdate(float DeltaTime) override {}
-	virtual void ResetSimulation() override {}
+	virtual void ResetSimulation() override;
+
+	/// Must be called on the game thread while the owning anim instance is not evaluating(AnimNode PreUpdate)
+	void UpdateAsyncQueries_GameThread();
+
+	/// Once per frame before simulation
+	void UpdateGeometryCache();
+	/// Every simulation step. Converts the cached convexes to the step's component space
+	void PrepareGeometryCache(const FTransform& ComponentTransform);
+	/// Every solve iteration. Cached sphere/capsule/box are solved by the local collision constraints, so only convexes are handled here
+	void SolveGeometryCache(float DeltaTime, bool bInitialUpdate, bool bFinalize);
+
+	/// World space movement test of the stationary bone skip. PrevComponentTransform is the component transform of the previous sweep.
+	static bool IsStationaryMotion(const FLKAnimVerletBone& InVerletBone, const FTransform& ComponentTransform, const FTransform& PrevComponentTransform, float InThreshold, bool bInInertialFrame);
 
 private:
+	void ConsumeAsyncQueries_GameThread(class UWorld* World);
+	void IssueAsyncQueries_GameThread(class UWorld* World);
+	void ApplyAsyncContactPlanes(float DeltaTime);
+	bool ApplyContactPlane(IN OUT FLKAnimVerletBone& CurVerletBone, const FVector& PlaneLocation, const FVector& PlaneNormal);
+	bool ApplyContactPlaneCapsule(IN OUT FLKAnimVerletBone& CurVerletBone, IN OUT FLKAnimVerletBone& ParentVerletBone, const FVector& PlaneLocation, const FVector& PlaneNormal);
+	/// Distributes a segment correction at ContactT(0: parent, 1: child) to both bones like the capsule sweep response
+	bool ApplyCapsuleCorrection(IN OUT FLKAnimVerletBone& CurVerletBone, IN OUT FLKAnimVerletBone& ParentVerletBone, float ContactT, const FVector& Correction, const FVector& CollisionNormal);
+	bool CheckConvexSphere(IN OUT FLKAnimVerletBone& CurVerletBone, const FLKAnimVerletWorldCachedConvex& InConvex);
+	const FLKAnimVerletWorldContactPlane* FindCachedContactPlane(int32 ElementIndex, const FVector& PrevWorldLoc, const FVector& CurWorldLoc, 
+																 const FVector& EndAWorldLoc, const FVector& EndBWorldLoc, float Radius);
+	void StoreCachedContactPlane(int32 ElementIndex, const struct FHitResult* HitResultNullable, const FVector& QueryWorldLoc);
+	bool ApplyCachedContactPlane(int32 ElementIndex, IN OUT FLKAnimVerletBone& CurVerletBone, FLKAnimVerletBone* ParentVerletBoneNullable, const FTransform& ComponentTransform);
+	bool IsStationaryBone(const FLKAnimVerletBone& InVerletBone, const FTransform& ComponentTransform) const;
+	bool HasStoredSweepResult(int32 ElementIndex) const;
+	inline bool UseContactPlaneStorage() const { return (bUseContactCache || bSkipStationaryBones); }
+	bool MakeSweptChainBound(OUT FLKAnimVerletBound& OutBound, float Margin) const;
+	bool IsChainClearOfWorld(const UWorld* World, const FTransform& ComponentTransform);
+	void AddPrimitiveToGeometryCache(const class UPrimitiveComponent& InPrimitive, int32 InBodyIndex);
+
 	bool CheckWorldSphere(IN OUT FLKAnimVerletBone& CurVerletBone, float DeltaTime, bool bInitialUpdate, bool bFinalize, const UWorld* World,
 						  const struct FCollisionQueryParams& CollisionQueryParams, const FTransform& ComponentTransform, int32 LambdaIndex);
 	void CheckWorldSphere(float DeltaTime, bool bInitialUpdate, bool bFinalize);
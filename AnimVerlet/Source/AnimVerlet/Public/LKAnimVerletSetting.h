@@ -123,6 +123,71 @@ public:
 	float MaxDistance = 0.0f;
 };
 
+/** Simulation limits used while the node significance is at least MinSignificance. */
+USTRUCT(BlueprintType)
+struct FLKAnimVerletSignificanceTier
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float MinSignificance = 0.0f;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD", meta = (ClampMin = "1"))
+	int32 MaxSolveIteration = 4;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD", meta = (ClampMin = "1"))
+	int32 MaxSubStep = 3;
+	/** Simulate every Nth frame. The delta time of the skipped frames is handed to the simulated frame. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD", meta = (ClampMin = "1"))
+	int32 UpdateInterval = 1;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD")
+	bool bAllowSelfCollision = true;
+
+public:
+	FLKAnimVerletSignificanceTier() = default;
+	FLKAnimVerletSignificanceTier(float InMinSignificance, int32 InMaxSolveIteration, int32 InMaxSubStep, int32 InUpdateInterval, bool bInAllowSelfCollision)
+		: MinSignificance(InMinSignificance), MaxSolveIteration(InMaxSolveIteration), MaxSubStep(InMaxSubStep), UpdateInterval(InUpdateInterval), bAllowSelfCollision(bInAllowSelfCollision)
+	{}
+};
+
+USTRUCT(BlueprintType)
+struct FLKAnimVerletLODFeatureSetting
+{
+	GENERATED_BODY()
+
+public:
+	/** Applied from this mesh LOD and above, until an entry with a higher MinLOD. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD", meta = (ClampMin = "0"))
+	int32 MinLOD = 0;
+	/** Upper clamp of SolveIteration. 0 keeps SolveIteration. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD", meta = (ClampMin = "0"))
+	int32 MaxSolveIteration = 0;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD")
+	bool bDisableSelfCollision = false;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD")
+	bool bDisableWorldCollision = false;
+	/** Skip isometric, 1D and flat bending constraints. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD")
+	bool bDisableBendingConstraints = false;
+	/** Skip cone angle(ball socket) constraints. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD")
+	bool bDisableConeAngleConstraints = false;
+	/** Collide with simulated bones as spheres instead of chain capsules/triangles(bUseCapsuleCollisionForChain). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD")
+	bool bUseSphereCollisionForChain = false;
+	/** 
+		Simulate only every Nth bone of each chain. Roots, tips, branches and locked bones are always simulated.
+		The skipped bones are interpolated between the simulated ones. Changing it rebuilds the topology and maps the particle state by bone.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD", meta = (ClampMin = "1", ClampMax = "8"))
+	int32 ChainResolutionStride = 1;
+	/** 
+		Replace the simulation with an analytic spring-damper per bone. Constraints and collisions are skipped.
+		The spring is driven by the component acceleration and gravity, and tuned by Stiffness, Damping and the inertia scales.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD")
+	bool bUseProceduralSway = false;
+};
+
 USTRUCT(BlueprintInternalUseOnly)
 struct FLKAnimVerletRandomForceSetting
 {
@@ -145,6 +210,9 @@ struct FLKAnimVerletUpdateParam
 	float Damping = 0.0f;
 	FVector ComponentMoveDiff = FVector::ZeroVector;
 	FQuat ComponentRotDiff = FQuat::Identity;
+	bool bApplyInertialDisplacement = false;
+	FVector InertialLinearDisplacement = FVector::ZeroVector;
+	FVector InertialAngularDisplacement = FVector::ZeroVector;
 	float StretchForce = 0.0f;
 	bool bAlignStretchForceToGravity = false;
 	float SideStraightenForce = 0.0f;
@@ -154,4 +222,25 @@ struct FLKAnimVerletUpdateParam
 	FVector ExternalForce = FVector::ZeroVector;
 	FLKAnimVerletRandomForceSetting RandomWind;
 	TArray<FLKAnimVerletRandomForceSetting, TInlineAllocator<8>> AdditionalRandomWinds;
+	float RandomWindNoiseFrequency = 0.0f;
+	FVector RandomWindNoiseOffset = FVector::ZeroVector;
+	uint32 RandomWindSeed = 0;
+
+public:
+	inline FVector MakeInertialDisplacement(const FVector& InLocation) const { return InertialLinearDisplacement + FVector::CrossProduct(InertialAngularDisplacement, InLocation); }
+	/// Component space displacement the component frame motion applies to a bone at InLocation in this step(rebase or inertial displacement)
+	inline FVector MakeComponentFrameDisplacement(const FVector& InLocation) const { return bApplyInertialDisplacement ? MakeInertialDisplacement(InLocation) : (ComponentRotDiff.RotateVector(InLocation) + ComponentMoveDiff - InLocation); }
+};
+
+/// Per frame parameter block. Only the component move delta and the wind noise offset of UpdateParam change between substeps
+struct FLKAnimVerletFrameUpdateParam
+{
+	FLKAnimVerletUpdateParam UpdateParam;
+	FVector ComponentRotVector = FVector::ZeroVector;						///Clamped component rotation delta of one substep as a rotation vector
+	bool bHasContinuousForce = false;										///Wind keeps bones moving, so islands are not allowed to sleep
+	bool bForceChanged = false;												///Gravity or external force changed since last frame(wakes sleeping islands)
+	float MoveInertiaFactor = 1.0f;											///Scale applied to each substep`s component move delta(clamp, ignore and MoveInertiaScale)
+	float AnimationPoseInertia = 0.0f;
+	float AnimationPoseDeltaInertia = 0.0f;
+	TArray<FVector, TInlineAllocator<8>> WindVelocitiesInCS;
 };
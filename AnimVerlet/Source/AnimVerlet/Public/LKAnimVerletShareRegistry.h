@@ -0,0 +1,53 @@
+#pragma once
+#include <CoreMinimal.h>
+#include <HAL/CriticalSection.h>
+#include "LKAnimVerletBone.h"
+
+///=========================================================================================================================================
+/// LKAnimVerletShareRegistry
+/// Global registry of share groups for crowds. Nodes with the same share key(mesh, settings hash, animation phase) form a group.
+/// The leader of each group simulates and publishes its pose relative result. Followers apply it to their own pose.
+/// Simulation cost scales with the number of groups instead of the number of instances.
+///=========================================================================================================================================
+class LKAnimVerletShareRegistry
+{
+public:
+	static constexpr int32 MaxPhaseOffsetFrames = 8;
+
+public:
+	static LKAnimVerletShareRegistry& Get();
+
+	/// Any thread. Joins the group of InShareKey and leaves the previous one. Returns true if the node leads its group and has to simulate.
+	bool UpdateMember(IN OUT int32& InOutHandle, uint32 InShareKey);
+	/// Leader only. Sorted by BonePoseIndex like the output.
+	void PublishResult(int32 InHandle, const TArray<FLKAnimVerletCachedBoneResult>& InResult);
+	/// Followers. InPhaseOffsetFrames selects an older result of the leader.
+	bool CopyResult(int32 InHandle, int32 InPhaseOffsetFrames, OUT TArray<FLKAnimVerletCachedBoneResult>& OutResult) const;
+
+private:
+	struct FLKShareMember
+	{
+		uint32 ShareKey = 0;
+		uint64 LastUpdateFrame = 0;
+	};
+
+	struct FLKShareGroup
+	{
+		int32 LeaderHandle = INDEX_NONE;
+		uint64 LeaderUpdateFrame = 0;
+		int32 NumMembers = 0;
+		TArray<FLKAnimVerletCachedBoneResult> ResultHistory[MaxPhaseOffsetFrames + 1];		///Ring buffer of published results
+		int32 LatestResultIndex = INDEX_NONE;
+		int32 NumResults = 0;
+	};
+
+	void LeaveGroup(int32 InHandle, uint32 InShareKey);
+	void PruneStaleMembers();
+
+private:
+	mutable FCriticalSection Lock;
+	TMap<int32, FLKShareMember> Members;
+	TMap<uint32, FLKShareGroup> Groups;
+	int32 NextHandle = 0;
+	uint64 LastPruneFrame = MAX_uint64;
+};
@@ -0,0 +1,43 @@
+#pragma once
+#include <CoreMinimal.h>
+#include <Engine/DataAsset.h>
+#include "LKAnimNode_AnimVerlet.h"
+#include "LKAnimVerletTopologyAsset.generated.h"
+
+///=========================================================================================================================================
+/// ULKAnimVerletTopologyAsset
+/// Simulation topology of an AnimVerlet node baked in the editor(bones, bone-to-bone constraints and chains built from the reference pose).
+/// Saved as one flat blob with bone pointers stored as indices. The node copies the arrays and only fixes up the pointers instead of walking the skeleton.
+///=========================================================================================================================================
+UCLASS(BlueprintType)
+class ANIMVERLET_API ULKAnimVerletTopologyAsset : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	/** Hash of the node settings the topology was built with */
+	UPROPERTY(VisibleAnywhere, Category = "Topology")
+	uint32 SettingsHash = 0;
+	/** Hash of the bone names, hierarchy and reference pose of the mesh the topology was built with */
+	UPROPERTY(VisibleAnywhere, Category = "Topology")
+	uint32 SkeletonHash = 0;
+	UPROPERTY(VisibleAnywhere, Category = "Topology")
+	int32 NumSimulateBones = 0;
+	UPROPERTY(VisibleAnywhere, Category = "Topology")
+	int32 NumConstraints = 0;
+
+public:
+	virtual void Serialize(FArchive& Ar) override;
+
+	bool HasTopology() const { return bValidTopology; }
+	bool IsUpToDate(uint32 InSettingsHash, uint32 InSkeletonHash) const { return (bValidTopology && SettingsHash == InSettingsHash && SkeletonHash == InSkeletonHash); }
+	/// Copies the baked arrays and rebases the bone pointers of the constraints onto the copies
+	void CopyTopology(OUT FLKAnimVerletSimulationTopology& OutTopology) const;
+	/// Takes the built arrays of InOutTopology(swapped, InOutTopology is left with the previous topology)
+	void SetTopology(IN OUT FLKAnimVerletSimulationTopology& InOutTopology, uint32 InSettingsHash, uint32 InSkeletonHash);
+
+private:
+	FLKAnimVerletSimulationTopology Topology;
+	bool bValidTopology = false;
+};
+///=========================================================================================================================================
\ No newline at end of file
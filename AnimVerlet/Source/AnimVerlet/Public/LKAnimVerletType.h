@@ -45,4 +45,30 @@ enum class ELKAnimVerletPreset : uint8
 		Gravity = FVector(0.0f, 0.0f, -980.0f);
 	*/
 	Physics_PBD
+};
+
+UENUM(BlueprintType)
+enum class ELKAnimVerletOffscreenMode : uint8
+{
+	/** Simulate regardless of visibility. */
+	Simulate,
+
+	/** Simulate every OffscreenUpdateInterval updates with the accumulated delta time. */
+	Throttle,
+
+	/** Hold the last result and drop the elapsed time. */
+	Skip
+};
+
+UENUM(BlueprintType)
+enum class ELKAnimVerletInitializationMode : uint8
+{
+	/** Build the simulation on the first evaluation. */
+	Immediate,
+
+	/** Like Immediate, but at most a.AnimNode.AnimVerlet.MaxInitializationsPerFrame nodes build per frame. The others pass the pose through and retry on the next frame. */
+	TimeSliced,
+
+	/** Build bones and constraints from the reference pose on a background task started at initialization. The pose passes through until the task is done. */
+	Async
 };
\ No newline at end of file
@@ -6,7 +6,7 @@ public class AnimVerletEditor : ModuleRules
 	{
 		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
 		
-		PrivateDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "AnimGraphRuntime", "AnimGraph", "BlueprintGraph", "Slate", "SlateCore", "Persona", "UnrealEd", "AnimVerlet" });
+		PrivateDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "AnimGraphRuntime", "AnimGraph", "BlueprintGraph", "Slate", "SlateCore", "Persona", "UnrealEd", "AssetRegistry", "AnimVerlet" });
 		
 		/// UE5 compatibility
 		BuildVersion Version;
@@ -6,11 +6,16 @@
 #include <DetailCategoryBuilder.h>
 #include <EngineGlobals.h>
 #include <PropertyHandle.h>
+#include <Animation/AnimBlueprint.h>
 #include <Animation/AnimInstance.h>
+#include <Animation/AnimSequence.h>
 #include <Framework/Notifications/NotificationManager.h>
+#include <Kismet2/BlueprintEditorUtils.h>
 #include <Materials/MaterialInstanceDynamic.h>
 #include <Widgets/Input/SButton.h>
 #include <Widgets/Notifications/SNotificationList.h>
+#include "LKAnimVerletBakeUtil.h"
+#include "LKAnimVerletTopologyAsset.h"
 
 #define LOCTEXT_NAMESPACE "AnimVerlet"
 ULKAnimGraphNode_AnimVerlet::ULKAnimGraphNode_AnimVerlet(const FObjectInitializer& ObjectInitializer)
@@ -137,6 +142,24 @@ void ULKAnimGraphNode_AnimVerlet::CustomizeDetails(IDetailLayoutBuilder& DetailB
 				.ToolTipText(LOCTEXT("ConvertFromPaButtonToolTip", "Convert CollisionPhysicsAsset to collision shape data list(Need to save the AnimBlueprint manually after convert)"))
 				.OnClicked(FOnClicked::CreateStatic(&ULKAnimGraphNode_AnimVerlet::ConvertFromPaButtonClicked, &DetailBuilder))
 		];
+
+	FDetailWidgetRow& BakeToAnimSequenceWidgetRow = AnimVerletToolCategory.AddCustomRow(LOCTEXT("BakeToAnimSequenceRow", "BakeToAnimSequence"));
+	BakeToAnimSequenceWidgetRow
+		[
+			SNew(SButton)
+				.Text(LOCTEXT("BakeToAnimSequenceButtonText", "Bake To AnimSequence"))
+				.ToolTipText(LOCTEXT("BakeToAnimSequenceButtonToolTip", "Simulate over BakeSourceSequence with the preview mesh and write the result to a new AnimSequence(Need to save the AnimSequence manually after bake)"))
+				.OnClicked(FOnClicked::CreateStatic(&ULKAnimGraphNode_AnimVerlet::BakeToAnimSequenceButtonClicked, &DetailBuilder))
+		];
+
+	FDetailWidgetRow& BakeTopologyAssetWidgetRow = AnimVerletToolCategory.AddCustomRow(LOCTEXT("BakeTopologyAssetRow", "BakeTopologyAsset"));
+	BakeTopologyAssetWidgetRow
+		[
+			SNew(SButton)
+				.Text(LOCTEXT("BakeTopologyAssetButtonText", "Bake Topology Asset"))
+				.ToolTipText(LOCTEXT("BakeTopologyAssetButtonToolTip", "Build the simulation topology with the preview mesh and write it to TopologyAsset(a new asset next to the AnimBlueprint if empty). Need to save the asset and compile the AnimBlueprint manually after bake"))
+				.OnClicked(FOnClicked::CreateStatic(&ULKAnimGraphNode_AnimVerlet::BakeTopologyAssetButtonClicked, &DetailBuilder))
+		];
 }
 
 void ULKAnimGraphNode_AnimVerlet::Draw(FPrimitiveDrawInterface* PDI, USkeletalMeshComponent* PreviewSkelMeshComp) const
@@ -616,6 +639,98 @@ void ULKAnimGraphNode_AnimVerlet::ApplyAnimVerletPresetType(FLKAnimNode_AnimVerl
 	InNode.ApplyPresetType(PresetType);
 }
 
+void ULKAnimGraphNode_AnimVerlet::BakeToAnimSequence()
+{
+	if (BakeSourceSequence == nullptr)
+	{
+		ShowNotification(FText::FromString(TEXT("BakeSourceSequence is required")), false);
+		return;
+	}
+
+	FLKAnimVerletBakeSetting BakeSetting;
+	UAnimBlueprint* AnimBlueprint = GetAnimBlueprint();
+	BakeSetting.SkeletalMesh = (AnimBlueprint != nullptr) ? AnimBlueprint->GetPreviewMesh() : nullptr;
+	if (BakeSetting.SkeletalMesh == nullptr && LastPreviewComponent != nullptr)
+		BakeSetting.SkeletalMesh = LastPreviewComponent->GetSkeletalMeshAsset();
+	BakeSetting.SourceSequence = BakeSourceSequence;
+	BakeSetting.FrameRate = BakeFrameRate;
+	BakeSetting.PreRollTime = BakePreRollTime;
+	BakeSetting.bAdditive = bBakeAsAdditive;
+	BakeSetting.OutputPackageName = LKAnimVerletBakeUtil::MakeDefaultOutputPackageName(BakeSourceSequence);
+
+	FText BakeError;
+	UAnimSequence* BakedSequence = LKAnimVerletBakeUtil::BakeToAnimSequence(Node, BakeSetting, OUT BakeError);
+	if (BakedSequence != nullptr)
+		ShowNotification(FText::Format(LOCTEXT("BakedToAnimSequence", "Baked to {0}"), FText::FromString(BakedSequence->GetPathName())), true);
+	else
+		ShowNotification(BakeError, false);
+}
+FReply ULKAnimGraphNode_AnimVerlet::BakeToAnimSequenceButtonClicked(IDetailLayoutBuilder* DetailLayoutBuilder)
+{
+	const TArray<TWeakObjectPtr<UObject>>& SelectedObjectsList = DetailLayoutBuilder->GetSelectedObjects();
+	for (TWeakObjectPtr<UObject> Object : SelectedObjectsList)
+	{
+		if (ULKAnimGraphNode_AnimVerlet* AnimVerletGraphNode = Cast<ULKAnimGraphNode_AnimVerlet>(Object.Get()))
+		{
+			AnimVerletGraphNode->BakeToAnimSequence();
+		}
+	}
+
+	return FReply::Handled();
+}
+
+void ULKAnimGraphNode_AnimVerlet::BakeTopologyAsset()
+{
+	UAnimBlueprint* AnimBlueprint = GetAnimBlueprint();
+	USkeletalMesh* SkeletalMesh = (AnimBlueprint != nullptr) ? AnimBlueprint->GetPreviewMesh() : nullptr;
+	if (SkeletalMesh == nullptr && LastPreviewComponent != nullptr)
+		SkeletalMesh = LastPreviewComponent->GetSkeletalMeshAsset();
+
+	/// Bake again in place, or next to the AnimBlueprint with the index of this node among its AnimVerlet nodes
+	FString OutputPackageName;
+	if (Node.TopologyAsset != nullptr)
+	{
+		OutputPackageName = Node.TopologyAsset->GetOutermost()->GetName();
+	}
+	else
+	{
+		TArray<ULKAnimGraphNode_AnimVerlet*> AnimVerletGraphNodes;
+		if (AnimBlueprint != nullptr)
+			FBlueprintEditorUtils::GetAllNodesOfClass<ULKAnimGraphNode_AnimVerlet>(AnimBlueprint, AnimVerletGraphNodes);
+		OutputPackageName = LKAnimVerletBakeUtil::MakeDefaultTopologyPackageName(AnimBlueprint, FMath::Max(AnimVerletGraphNodes.IndexOfByKey(this), 0));
+	}
+
+	FText BakeError;
+	ULKAnimVerletTopologyAsset* BakedAsset = LKAnimVerletBakeUtil::BakeTopologyAsset(Node, SkeletalMesh, OutputPackageName, OUT BakeError);
+	if (BakedAsset == nullptr)
+	{
+		ShowNotification(BakeError, false);
+		return;
+	}
+
+	if (Node.TopologyAsset != BakedAsset)
+	{
+		Modify();
+		Node.TopologyAsset = BakedAsset;
+		if (AnimBlueprint != nullptr)
+			FBlueprintEditorUtils::MarkBlueprintAsModified(AnimBlueprint);
+	}
+	ShowNotification(FText::Format(LOCTEXT("BakedTopologyAsset", "Baked topology to {0}"), FText::FromString(BakedAsset->GetPathName())), true);
+}
+FReply ULKAnimGraphNode_AnimVerlet::BakeTopologyAssetButtonClicked(IDetailLayoutBuilder* DetailLayoutBuilder)
+{
+	const TArray<TWeakObjectPtr<UObject>>& SelectedObjectsList = DetailLayoutBuilder->GetSelectedObjects();
+	for (TWeakObjectPtr<UObject> Object : SelectedObjectsList)
+	{
+		if (ULKAnimGraphNode_AnimVerlet* AnimVerletGraphNode = Cast<ULKAnimGraphNode_AnimVerlet>(Object.Get()))
+		{
+			AnimVerletGraphNode->BakeTopologyAsset();
+		}
+	}
+
+	return FReply::Handled();
+}
+
 FLKAnimNode_AnimVerlet* ULKAnimGraphNode_AnimVerlet::GetPreviewAnimVerletNode() const
 {
 	FLKAnimNode_AnimVerlet* ActivePreviewNode = nullptr;
@@ -0,0 +1,96 @@
+#include "LKAnimVerletBakeAnimInstance.h"
+
+#include <Animation/AnimSequence.h>
+#include <Animation/AnimNodeBase.h>
+#include <BonePose.h>
+
+///=========================================================================================================================================
+/// FLKAnimVerletBakeAnimInstanceProxy
+///=========================================================================================================================================
+void FLKAnimVerletBakeAnimInstanceProxy::UpdateAnimationNode(const FAnimationUpdateContext& InContext)
+{
+	if (bNodeInitialized == false)
+	{
+		bNodeInitialized = true;
+		AnimVerletNode.Initialize_AnyThread(FAnimationInitializeContext(this));
+	}
+
+	/// Required bones change with the mesh LOD. Bone references of the node have to follow them like CacheBones of a compiled graph.
+	if (CachedBonesSerialNumber != GetRequiredBones().GetSerialNumber())
+	{
+		CachedBonesSerialNumber = GetRequiredBones().GetSerialNumber();
+		AnimVerletNode.CacheBones_AnyThread(FAnimationCacheBonesContext(this));
+	}
+
+	AnimVerletNode.Update_AnyThread(InContext);
+}
+
+bool FLKAnimVerletBakeAnimInstanceProxy::Evaluate(FPoseContext& Output)
+{
+	if (SourceSequence == nullptr)
+		return false;
+
+	FAnimationPoseData SourcePoseData(Output);
+	SourceSequence->GetAnimationPose(SourcePoseData, FAnimExtractContext(static_cast<double>(SourceTime), false));
+
+	if (bNodeInitialized == false || AnimVerletNode.VerletBones.Num() == 0)
+		return true;
+
+	FComponentSpacePoseContext ComponentSpaceContext(this);
+	ComponentSpaceContext.Pose.InitPose(Output.Pose);
+	ComponentSpaceContext.Curve = Output.Curve;
+	ComponentSpaceContext.CustomAttributes = Output.CustomAttributes;
+
+	TArray<FBoneTransform> BoneTransforms;
+	AnimVerletNode.EvaluateSkeletalControl_AnyThread(ComponentSpaceContext, BoneTransforms);
+	if (BoneTransforms.Num() > 0)
+		ComponentSpaceContext.Pose.LocalBlendCSBoneTransforms(BoneTransforms, 1.0f);
+
+	FCSPose<FCompactPose>::ConvertComponentPosesToLocalPoses(MoveTemp(ComponentSpaceContext.Pose), Output.Pose);
+	return true;
+}
+
+
+///=========================================================================================================================================
+/// ULKAnimVerletBakeAnimInstance
+///=========================================================================================================================================
+void ULKAnimVerletBakeAnimInstance::SetupBake(const FLKAnimNode_AnimVerlet& InAnimVerletNode, UAnimSequence* InSourceSequence)
+{
+	SourceSequence = InSourceSequence;
+
+	FLKAnimVerletBakeAnimInstanceProxy& Proxy = GetProxyOnGameThread<FLKAnimVerletBakeAnimInstanceProxy>();
+	Proxy.AnimVerletNode = InAnimVerletNode;
+	Proxy.AnimVerletNode.bActivate = true;
+	Proxy.AnimVerletNode.bUseSignificanceLOD = false;
+	Proxy.AnimVerletNode.bUseBudgetScheduler = false;
+	Proxy.AnimVerletNode.OffscreenMode = ELKAnimVerletOffscreenMode::Simulate;
+	Proxy.AnimVerletNode.bShareSimulationResult = false;
+	Proxy.AnimVerletNode.InitializationMode = ELKAnimVerletInitializationMode::Immediate;
+	Proxy.SourceSequence = InSourceSequence;
+	Proxy.SourceTime = 0.0f;
+}
+
+void ULKAnimVerletBakeAnimInstance::SetSourceTime(float InSourceTime)
+{
+	GetProxyOnGameThread<FLKAnimVerletBakeAnimInstanceProxy>().SourceTime = InSourceTime;
+}
+
+FAnimInstanceProxy* ULKAnimVerletBakeAnimInstance::CreateAnimInstanceProxy()
+{
+	return new FLKAnimVerletBakeAnimInstanceProxy(this);
+}
+
+void ULKAnimVerletBakeAnimInstance::DestroyAnimInstanceProxy(FAnimInstanceProxy* InProxy)
+{
+	delete static_cast<FLKAnimVerletBakeAnimInstanceProxy*>(InProxy);
+}
+
+void ULKAnimVerletBakeAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
+{
+	Super::NativeUpdateAnimation(DeltaSeconds);
+
+	/// Compiled graphs call PreUpdate of their nodes here(async world collision, wind components)
+	FLKAnimVerletBakeAnimInstanceProxy& Proxy = GetProxyOnGameThread<FLKAnimVerletBakeAnimInstanceProxy>();
+	if (Proxy.AnimVerletNode.HasPreUpdate())
+		Proxy.AnimVerletNode.PreUpdate(this);
+}
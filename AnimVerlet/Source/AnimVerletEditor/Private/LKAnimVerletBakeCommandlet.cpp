@@ -0,0 +1,153 @@
+#include "LKAnimVerletBakeCommandlet.h"
+
+#include <Animation/AnimBlueprint.h>
+#include <Animation/AnimSequence.h>
+#include <Engine/SkeletalMesh.h>
+#include <Misc/PackageName.h>
+#include <UObject/Package.h>
+#include <UObject/SavePackage.h>
+#include "LKAnimGraphNode_AnimVerlet.h"
+#include "LKAnimVerletBakeUtil.h"
+#include "LKAnimVerletTopologyAsset.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogAnimVerletBake, Log, All);
+
+ULKAnimVerletBakeCommandlet::ULKAnimVerletBakeCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 ULKAnimVerletBakeCommandlet::Main(const FString& Params)
+{
+	FString AnimBlueprintPath;
+	FString SourcePaths;
+	const bool bBakeTopology = FParse::Param(*Params, TEXT("Topology"));
+	if (FParse::Value(*Params, TEXT("AnimBlueprint="), AnimBlueprintPath) == false || (bBakeTopology == false && FParse::Value(*Params, TEXT("Source="), SourcePaths, false) == false))
+	{
+		UE_LOG(LogAnimVerletBake, Error, TEXT("Usage: -run=LKAnimVerletBake -AnimBlueprint=<Path> -Source=<Path>[,<Path>...] [-Mesh=<Path>] [-Output=<PackageName>] [-NodeIndex=0] [-FrameRate=30] [-PreRoll=1.0] [-Additive]"));
+		UE_LOG(LogAnimVerletBake, Error, TEXT("       -run=LKAnimVerletBake -AnimBlueprint=<Path> -Topology [-Mesh=<Path>] [-Output=<PackageName>] [-NodeIndex=0]"));
+		return 1;
+	}
+
+	UAnimBlueprint* AnimBlueprint = LoadObject<UAnimBlueprint>(nullptr, *AnimBlueprintPath);
+	if (AnimBlueprint == nullptr)
+	{
+		UE_LOG(LogAnimVerletBake, Error, TEXT("Failed to load AnimBlueprint %s"), *AnimBlueprintPath);
+		return 1;
+	}
+
+	int32 NodeIndex = 0;
+	FParse::Value(*Params, TEXT("NodeIndex="), NodeIndex);
+	const ULKAnimGraphNode_AnimVerlet* AnimVerletGraphNode = LKAnimVerletBakeUtil::FindAnimVerletGraphNode(AnimBlueprint, NodeIndex);
+	if (AnimVerletGraphNode == nullptr)
+	{
+		UE_LOG(LogAnimVerletBake, Error, TEXT("%s has no AnimVerlet node at index %d"), *AnimBlueprintPath, NodeIndex);
+		return 1;
+	}
+
+	FLKAnimVerletBakeSetting BakeSetting;
+	FString MeshPath;
+	if (FParse::Value(*Params, TEXT("Mesh="), MeshPath))
+		BakeSetting.SkeletalMesh = LoadObject<USkeletalMesh>(nullptr, *MeshPath);
+	else
+		BakeSetting.SkeletalMesh = AnimBlueprint->GetPreviewMesh();
+
+	if (BakeSetting.SkeletalMesh == nullptr)
+	{
+		UE_LOG(LogAnimVerletBake, Error, TEXT("No SkeletalMesh. Pass -Mesh= or set the preview mesh of %s"), *AnimBlueprintPath);
+		return 1;
+	}
+
+	if (bBakeTopology)
+		return BakeTopologyAsset(Params, AnimBlueprint, NodeIndex, AnimVerletGraphNode->Node, BakeSetting.SkeletalMesh);
+
+	FParse::Value(*Params, TEXT("FrameRate="), BakeSetting.FrameRate);
+	FParse::Value(*Params, TEXT("PreRoll="), BakeSetting.PreRollTime);
+	BakeSetting.bAdditive = FParse::Param(*Params, TEXT("Additive"));
+
+	TArray<FString> SourcePathList;
+	SourcePaths.ParseIntoArray(SourcePathList, TEXT(","), true);
+
+	FString OutputPackageName;
+	const bool bHasOutput = FParse::Value(*Params, TEXT("Output="), OutputPackageName);
+	if (bHasOutput && SourcePathList.Num() > 1)
+		UE_LOG(LogAnimVerletBake, Warning, TEXT("-Output is ignored with multiple sources"));
+
+	int32 NumFailed = 0;
+	for (const FString& CurSourcePath : SourcePathList)
+	{
+		BakeSetting.SourceSequence = LoadObject<UAnimSequence>(nullptr, *CurSourcePath);
+		if (BakeSetting.SourceSequence == nullptr)
+		{
+			UE_LOG(LogAnimVerletBake, Error, TEXT("Failed to load AnimSequence %s"), *CurSourcePath);
+			++NumFailed;
+			continue;
+		}
+		BakeSetting.OutputPackageName = (bHasOutput && SourcePathList.Num() == 1) ? OutputPackageName : LKAnimVerletBakeUtil::MakeDefaultOutputPackageName(BakeSetting.SourceSequence);
+
+		FText BakeError;
+		UAnimSequence* BakedSequence = LKAnimVerletBakeUtil::BakeToAnimSequence(AnimVerletGraphNode->Node, BakeSetting, OUT BakeError);
+		if (BakedSequence == nullptr)
+		{
+			UE_LOG(LogAnimVerletBake, Error, TEXT("Failed to bake %s: %s"), *CurSourcePath, *BakeError.ToString());
+			++NumFailed;
+			continue;
+		}
+
+		UPackage* BakedPackage = BakedSequence->GetOutermost();
+		const FString PackageFileName = FPackageName::LongPackageNameToFilename(BakedPackage->GetName(), FPackageName::GetAssetPackageExtension());
+		FSavePackageArgs SaveArgs;
+		SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+		SaveArgs.SaveFlags = SAVE_NoError;
+		if (UPackage::SavePackage(BakedPackage, BakedSequence, *PackageFileName, SaveArgs) == false)
+		{
+			UE_LOG(LogAnimVerletBake, Error, TEXT("Failed to save %s"), *PackageFileName);
+			++NumFailed;
+			continue;
+		}
+
+		UE_LOG(LogAnimVerletBake, Display, TEXT("Baked %s to %s"), *CurSourcePath, *BakedPackage->GetName());
+	}
+
+	return (NumFailed == 0) ? 0 : 1;
+}
+
+int32 ULKAnimVerletBakeCommandlet::BakeTopologyAsset(const FString& Params, const UAnimBlueprint* InAnimBlueprint, int32 InNodeIndex, 
+													 const FLKAnimNode_AnimVerlet& InAnimVerletNode, USkeletalMesh* InSkeletalMesh)
+{
+	/// Bake again in place when the node already references an asset so that the AnimBlueprint does not have to be resaved
+	FString OutputPackageName;
+	if (FParse::Value(*Params, TEXT("Output="), OutputPackageName) == false)
+	{
+		OutputPackageName = (InAnimVerletNode.TopologyAsset != nullptr) ? InAnimVerletNode.TopologyAsset->GetOutermost()->GetName() 
+																		 : LKAnimVerletBakeUtil::MakeDefaultTopologyPackageName(InAnimBlueprint, InNodeIndex);
+	}
+
+	FText BakeError;
+	ULKAnimVerletTopologyAsset* BakedAsset = LKAnimVerletBakeUtil::BakeTopologyAsset(InAnimVerletNode, InSkeletalMesh, OutputPackageName, OUT BakeError);
+	if (BakedAsset == nullptr)
+	{
+		UE_LOG(LogAnimVerletBake, Error, TEXT("Failed to bake topology of %s: %s"), *InAnimBlueprint->GetPathName(), *BakeError.ToString());
+		return 1;
+	}
+
+	UPackage* BakedPackage = BakedAsset->GetOutermost();
+	const FString PackageFileName = FPackageName::LongPackageNameToFilename(BakedPackage->GetName(), FPackageName::GetAssetPackageExtension());
+	FSavePackageArgs SaveArgs;
+	SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+	SaveArgs.SaveFlags = SAVE_NoError;
+	if (UPackage::SavePackage(BakedPackage, BakedAsset, *PackageFileName, SaveArgs) == false)
+	{
+		UE_LOG(LogAnimVerletBake, Error, TEXT("Failed to save %s"), *PackageFileName);
+		return 1;
+	}
+
+	UE_LOG(LogAnimVerletBake, Display, TEXT("Baked topology of %s to %s(%d bones, %d constraints)"), *InAnimBlueprint->GetPathName(), *BakedPackage->GetName(), 
+		   BakedAsset->NumSimulateBones, BakedAsset->NumConstraints);
+	if (InAnimVerletNode.TopologyAsset != BakedAsset)
+		UE_LOG(LogAnimVerletBake, Warning, TEXT("Set TopologyAsset of the node to %s and resave %s"), *BakedPackage->GetName(), *InAnimBlueprint->GetPathName());
+	return 0;
+}
\ No newline at end of file
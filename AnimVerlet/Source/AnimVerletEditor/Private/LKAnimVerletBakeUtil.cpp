@@ -0,0 +1,306 @@
+#include "LKAnimVerletBakeUtil.h"
+
+#include <Engine/Engine.h>
+#include <Engine/SkeletalMesh.h>
+#include <Engine/World.h>
+#include <Animation/AnimBlueprint.h>
+#include <Animation/AnimInstance.h>
+#include <Animation/AnimSequence.h>
+#include <Animation/Skeleton.h>
+#include <Animation/AnimData/IAnimationDataController.h>
+#include <Animation/AnimData/IAnimationDataModel.h>
+#include <AssetRegistry/AssetRegistryModule.h>
+#include <Components/SkeletalMeshComponent.h>
+#include <Kismet2/BlueprintEditorUtils.h>
+#include <Misc/PackageName.h>
+#include "LKAnimGraphNode_AnimVerlet.h"
+#include "LKAnimNode_AnimVerlet.h"
+#include "LKAnimVerletBakeAnimInstance.h"
+#include "LKAnimVerletTopologyAsset.h"
+
+#define LOCTEXT_NAMESPACE "AnimVerlet"
+
+namespace LkAnimVerlet
+{
+	/// Time of the looping source InFramesBeforeStart frames before its start
+	static float GetPreRollSourceTime(int32 InFramesBeforeStart, float InDeltaTime, float InSequenceLength)
+	{
+		if (InSequenceLength <= UE_SMALL_NUMBER)
+			return 0.0f;
+
+		const float WrappedTime = FMath::Fmod(-static_cast<float>(InFramesBeforeStart) * InDeltaTime, InSequenceLength);
+		return (WrappedTime < 0.0f) ? WrappedTime + InSequenceLength : WrappedTime;
+	}
+
+	/// Transient world without viewport. Nothing is rendered, the component only has to be registered for the anim instance.
+	static USkeletalMeshComponent* CreateBakeComponent(USkeletalMesh* InSkeletalMesh, OUT UWorld*& OutBakeWorld)
+	{
+		OutBakeWorld = UWorld::CreateWorld(EWorldType::EditorPreview, false, TEXT("AnimVerletBakeWorld"));
+		FWorldContext& BakeWorldContext = GEngine->CreateNewWorldContext(EWorldType::EditorPreview);
+		BakeWorldContext.SetCurrentWorld(OutBakeWorld);
+
+		USkeletalMeshComponent* BakeComponent = NewObject<USkeletalMeshComponent>(GetTransientPackage(), NAME_None, RF_Transient);
+		BakeComponent->SetSkeletalMesh(InSkeletalMesh);
+		BakeComponent->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+		BakeComponent->SetForcedLOD(1);
+		BakeComponent->SetAnimationMode(EAnimationMode::AnimationBlueprint);
+		BakeComponent->SetAnimInstanceClass(ULKAnimVerletBakeAnimInstance::StaticClass());
+		BakeComponent->RegisterComponentWithWorld(OutBakeWorld);
+		return BakeComponent;
+	}
+
+	static void DestroyBakeComponent(UWorld* InBakeWorld, USkeletalMeshComponent* InBakeComponent)
+	{
+		InBakeComponent->UnregisterComponent();
+		InBakeComponent->MarkAsGarbage();
+		GEngine->DestroyWorldContext(InBakeWorld);
+		InBakeWorld->DestroyWorld(false);
+	}
+
+	/// Returns the object to write at InPackageName, nullptr with OutError when the name is taken by another type
+	template <typename TAsset>
+	static TAsset* FindOrCreateBakeOutput(const FString& InPackageName, OUT bool& bOutNewAsset, OUT FText& OutError)
+	{
+		FText PackageNameError;
+		if (FPackageName::IsValidLongPackageName(InPackageName, false, &PackageNameError) == false)
+		{
+			OutError = PackageNameError;
+			return nullptr;
+		}
+
+		const FString OutputAssetName = FPackageName::GetLongPackageAssetName(InPackageName);
+		UPackage* OutputPackage = CreatePackage(*InPackageName);
+		UObject* ExistingObject = StaticFindObject(UObject::StaticClass(), OutputPackage, *OutputAssetName);
+		if (ExistingObject != nullptr && ExistingObject->IsA<TAsset>() == false)
+		{
+			OutError = FText::Format(LOCTEXT("BakeOutputExists", "{0} already exists and is not a {1}"), FText::FromString(InPackageName), TAsset::StaticClass()->GetDisplayNameText());
+			return nullptr;
+		}
+
+		bOutNewAsset = (ExistingObject == nullptr);
+		if (bOutNewAsset)
+			return NewObject<TAsset>(OutputPackage, *OutputAssetName, RF_Public | RF_Standalone);
+
+		ExistingObject->Modify();
+		return Cast<TAsset>(ExistingObject);
+	}
+}
+
+UAnimSequence* LKAnimVerletBakeUtil::BakeToAnimSequence(const FLKAnimNode_AnimVerlet& InAnimVerletNode, const FLKAnimVerletBakeSetting& InSetting, OUT FText& OutError)
+{
+	USkeletalMesh* SkeletalMesh = InSetting.SkeletalMesh;
+	UAnimSequence* SourceSequence = InSetting.SourceSequence;
+	if (SkeletalMesh == nullptr || SourceSequence == nullptr)
+	{
+		OutError = LOCTEXT("BakeNoInput", "SkeletalMesh and SourceSequence are required");
+		return nullptr;
+	}
+
+	USkeleton* Skeleton = SkeletalMesh->GetSkeleton();
+	if (Skeleton == nullptr || Skeleton->IsCompatibleForEditor(SourceSequence->GetSkeleton()) == false)
+	{
+		OutError = LOCTEXT("BakeSkeletonMismatch", "SourceSequence is not compatible with the skeleton of the SkeletalMesh");
+		return nullptr;
+	}
+
+	if (InAnimVerletNode.VerletBones.Num() == 0)
+	{
+		OutError = LOCTEXT("BakeNoVerletBones", "The AnimVerlet node has no VerletBones");
+		return nullptr;
+	}
+
+	if (InSetting.FrameRate <= 0)
+	{
+		OutError = LOCTEXT("BakeInvalidFrameRate", "FrameRate has to be positive");
+		return nullptr;
+	}
+
+	bool bNewAsset = false;
+	UAnimSequence* OutputSequence = LkAnimVerlet::FindOrCreateBakeOutput<UAnimSequence>(InSetting.OutputPackageName, OUT bNewAsset, OUT OutError);
+	if (OutputSequence == nullptr)
+		return nullptr;
+
+	UWorld* BakeWorld = nullptr;
+	USkeletalMeshComponent* BakeComponent = LkAnimVerlet::CreateBakeComponent(SkeletalMesh, OUT BakeWorld);
+	ULKAnimVerletBakeAnimInstance* BakeAnimInstance = Cast<ULKAnimVerletBakeAnimInstance>(BakeComponent->GetAnimInstance());
+	if (BakeAnimInstance == nullptr)
+	{
+		LkAnimVerlet::DestroyBakeComponent(BakeWorld, BakeComponent);
+		if (bNewAsset)
+			OutputSequence->MarkAsGarbage();
+		OutError = LOCTEXT("BakeNoAnimInstance", "Failed to create the bake anim instance");
+		return nullptr;
+	}
+	BakeAnimInstance->SetupBake(InAnimVerletNode, SourceSequence);
+
+	const float DeltaTime = 1.0f / static_cast<float>(InSetting.FrameRate);
+	const float SequenceLength = static_cast<float>(SourceSequence->GetPlayLength());
+	const int32 NumKeys = FMath::Max(FMath::RoundToInt(SequenceLength * static_cast<float>(InSetting.FrameRate)), 1) + 1;
+	const int32 NumPreRollFrames = FMath::Max(FMath::RoundToInt(InSetting.PreRollTime * static_cast<float>(InSetting.FrameRate)), 0);
+
+	auto TickBake = [BakeAnimInstance, BakeComponent, DeltaTime](float InSourceTime)
+	{
+		BakeAnimInstance->SetSourceTime(InSourceTime);
+		BakeComponent->TickAnimation(DeltaTime, false);
+		BakeComponent->RefreshBoneTransforms();
+	};
+
+	/// Pre-roll over the end of the looping source so the first key is not the rest pose
+	for (int32 PreRollFrame = NumPreRollFrames; PreRollFrame > 0; --PreRollFrame)
+		TickBake(LkAnimVerlet::GetPreRollSourceTime(PreRollFrame, DeltaTime, SequenceLength));
+
+	/// Mesh bone space, indexed by mesh bone index
+	const FReferenceSkeleton& RefSkeleton = SkeletalMesh->GetRefSkeleton();
+	const int32 NumBones = RefSkeleton.GetNum();
+	TArray<TArray<FVector3f>> PositionKeys;
+	TArray<TArray<FQuat4f>> RotationKeys;
+	TArray<TArray<FVector3f>> ScaleKeys;
+	PositionKeys.SetNum(NumBones);
+	RotationKeys.SetNum(NumBones);
+	ScaleKeys.SetNum(NumBones);
+	for (int32 BoneIndex = 0; BoneIndex < NumBones; ++BoneIndex)
+	{
+		PositionKeys[BoneIndex].Reserve(NumKeys);
+		RotationKeys[BoneIndex].Reserve(NumKeys);
+		ScaleKeys[BoneIndex].Reserve(NumKeys);
+	}
+
+	for (int32 KeyIndex = 0; KeyIndex < NumKeys; ++KeyIndex)
+	{
+		TickBake(FMath::Min(static_cast<float>(KeyIndex) * DeltaTime, SequenceLength));
+
+		const TArray<FTransform>& BoneSpaceTransforms = BakeComponent->GetBoneSpaceTransforms();
+		for (int32 BoneIndex = 0; BoneIndex < NumBones; ++BoneIndex)
+		{
+			const FTransform& BoneTransform = BoneSpaceTransforms.IsValidIndex(BoneIndex) ? BoneSpaceTransforms[BoneIndex] : RefSkeleton.GetRefBonePose()[BoneIndex];
+			PositionKeys[BoneIndex].Emplace(BoneTransform.GetTranslation());
+			RotationKeys[BoneIndex].Emplace(BoneTransform.GetRotation().GetNormalized());
+			ScaleKeys[BoneIndex].Emplace(BoneTransform.GetScale3D());
+		}
+	}
+	LkAnimVerlet::DestroyBakeComponent(BakeWorld, BakeComponent);
+
+	/// Write the new sequence
+	OutputSequence->SetSkeleton(Skeleton);
+	OutputSequence->SetPreviewMesh(SkeletalMesh);
+	OutputSequence->bEnableRootMotion = SourceSequence->bEnableRootMotion;
+	OutputSequence->RootMotionRootLock = SourceSequence->RootMotionRootLock;
+	OutputSequence->bLoop = SourceSequence->bLoop;
+	OutputSequence->Interpolation = SourceSequence->Interpolation;
+
+	/// The engine computes the additive delta from the raw keys. AnimScaled samples the source at the same normalized time.
+	OutputSequence->AdditiveAnimType = InSetting.bAdditive ? AAT_LocalSpaceBase : AAT_None;
+	OutputSequence->RefPoseType = InSetting.bAdditive ? ABPT_AnimScaled : ABPT_RefPose;
+	OutputSequence->RefPoseSeq = InSetting.bAdditive ? SourceSequence : nullptr;
+
+	IAnimationDataController& Controller = OutputSequence->GetController();
+	Controller.OpenBracket(LOCTEXT("BakeAnimVerlet", "Bake AnimVerlet"), false);
+	Controller.InitializeModel();
+	Controller.RemoveAllBoneTracks(false);
+	Controller.RemoveAllCurvesOfType(ERawCurveTrackTypes::RCT_Float, false);
+	Controller.SetFrameRate(FFrameRate(InSetting.FrameRate, 1), false);
+	Controller.SetNumberOfFrames(FFrameNumber(NumKeys - 1), false);
+
+	for (int32 BoneIndex = 0; BoneIndex < NumBones; ++BoneIndex)
+	{
+		const FName BoneName = RefSkeleton.GetBoneName(BoneIndex);
+		Controller.AddBoneTrack(BoneName, false);
+		Controller.SetBoneTrackKeys(BoneName, PositionKeys[BoneIndex], RotationKeys[BoneIndex], ScaleKeys[BoneIndex], false);
+	}
+
+	/// Curves are kept for the full sequence only. In the additive they would be subtracted to zero.
+	if (InSetting.bAdditive == false)
+	{
+		for (const FFloatCurve& SourceCurve : SourceSequence->GetDataModel()->GetFloatCurves())
+		{
+			const FAnimationCurveIdentifier CurveId(SourceCurve.GetName(), ERawCurveTrackTypes::RCT_Float);
+			Controller.AddCurve(CurveId, SourceCurve.GetCurveTypeFlags(), false);
+			Controller.SetCurveKeys(CurveId, SourceCurve.FloatCurve.GetConstRefOfKeys(), false);
+		}
+	}
+
+	Controller.NotifyPopulated();
+	Controller.CloseBracket(false);
+
+	OutputSequence->PostEditChange();
+	OutputSequence->MarkPackageDirty();
+	if (bNewAsset)
+		FAssetRegistryModule::AssetCreated(OutputSequence);
+
+	return OutputSequence;
+}
+
+const ULKAnimGraphNode_AnimVerlet* LKAnimVerletBakeUtil::FindAnimVerletGraphNode(const UAnimBlueprint* InAnimBlueprint, int32 InNodeIndex)
+{
+	if (InAnimBlueprint == nullptr)
+		return nullptr;
+
+	TArray<ULKAnimGraphNode_AnimVerlet*> AnimVerletGraphNodes;
+	FBlueprintEditorUtils::GetAllNodesOfClass<ULKAnimGraphNode_AnimVerlet>(InAnimBlueprint, AnimVerletGraphNodes);
+	return AnimVerletGraphNodes.IsValidIndex(InNodeIndex) ? AnimVerletGraphNodes[InNodeIndex] : nullptr;
+}
+
+FString LKAnimVerletBakeUtil::MakeDefaultOutputPackageName(const UAnimSequence* InSourceSequence)
+{
+	if (InSourceSequence == nullptr)
+		return FString();
+
+	const FString SourcePackagePath = FPackageName::GetLongPackagePath(InSourceSequence->GetOutermost()->GetName());
+	return SourcePackagePath / (InSourceSequence->GetName() + TEXT("_AnimVerlet"));
+}
+
+ULKAnimVerletTopologyAsset* LKAnimVerletBakeUtil::BakeTopologyAsset(const FLKAnimNode_AnimVerlet& InAnimVerletNode, USkeletalMesh* InSkeletalMesh, const FString& InOutputPackageName, OUT FText& OutError)
+{
+	if (InSkeletalMesh == nullptr)
+	{
+		OutError = LOCTEXT("BakeTopologyNoMesh", "SkeletalMesh is required");
+		return nullptr;
+	}
+
+	if (InAnimVerletNode.VerletBones.Num() == 0)
+	{
+		OutError = LOCTEXT("BakeNoVerletBones", "The AnimVerlet node has no VerletBones");
+		return nullptr;
+	}
+
+	bool bNewAsset = false;
+	ULKAnimVerletTopologyAsset* OutputAsset = LkAnimVerlet::FindOrCreateBakeOutput<ULKAnimVerletTopologyAsset>(InOutputPackageName, OUT bNewAsset, OUT OutError);
+	if (OutputAsset == nullptr)
+		return nullptr;
+
+	/// One tick brings the required bones of the forced LOD 0 up to date. The bake anim instance has no AnimVerlet bones yet, so nothing is simulated.
+	UWorld* BakeWorld = nullptr;
+	USkeletalMeshComponent* BakeComponent = LkAnimVerlet::CreateBakeComponent(InSkeletalMesh, OUT BakeWorld);
+	bool bBaked = false;
+	if (UAnimInstance* BakeAnimInstance = BakeComponent->GetAnimInstance())
+	{
+		BakeComponent->TickAnimation(0.0f, false);
+		bBaked = InAnimVerletNode.BakeTopologyAsset(OUT *OutputAsset, BakeAnimInstance->GetRequiredBones());
+	}
+	LkAnimVerlet::DestroyBakeComponent(BakeWorld, BakeComponent);
+
+	if (bBaked == false)
+	{
+		if (bNewAsset)
+			OutputAsset->MarkAsGarbage();
+		OutError = LOCTEXT("BakeTopologyFailed", "No simulate bones were built. Check the root bones of VerletBones against the SkeletalMesh");
+		return nullptr;
+	}
+
+	OutputAsset->MarkPackageDirty();
+	if (bNewAsset)
+		FAssetRegistryModule::AssetCreated(OutputAsset);
+
+	return OutputAsset;
+}
+
+FString LKAnimVerletBakeUtil::MakeDefaultTopologyPackageName(const UAnimBlueprint* InAnimBlueprint, int32 InNodeIndex)
+{
+	if (InAnimBlueprint == nullptr)
+		return FString();
+
+	const FString BlueprintPackagePath = FPackageName::GetLongPackagePath(InAnimBlueprint->GetOutermost()->GetName());
+	const FString AssetName = InAnimBlueprint->GetName() + TEXT("_AnimVerletTopology");
+	return BlueprintPackagePath / ((InNodeIndex > 0) ? FString::Printf(TEXT("%s_%d"), *AssetName, InNodeIndex) : AssetName);
+}
+#undef LOCTEXT_NAMESPACE
\ No newline at end of file
@@ -15,6 +15,8 @@ public:
 	static FReply ConvertFromDaButtonClicked(IDetailLayoutBuilder* DetailLayoutBuilder);
 	static FReply ConvertFromPaToDaButtonClicked(IDetailLayoutBuilder* DetailLayoutBuilder);
 	static FReply ConvertFromPaButtonClicked(IDetailLayoutBuilder* DetailLayoutBuilder);
+	static FReply BakeToAnimSequenceButtonClicked(IDetailLayoutBuilder* DetailLayoutBuilder);
+	static FReply BakeTopologyAssetButtonClicked(IDetailLayoutBuilder* DetailLayoutBuilder);
 
 public:
 	ULKAnimGraphNode_AnimVerlet(const FObjectInitializer& ObjectInitializer);
@@ -24,6 +26,8 @@ public:
 	void ConvertCollisionShapesFromDataAsset();
 	void ConvertPhysicsAssetToDataAsset();
 	void ConvertCollisionShapesFromPhysicsAsset();
+	void BakeToAnimSequence();
+	void BakeTopologyAsset();
 
 	void ApplyAnimVerletPresetType(FLKAnimNode_AnimVerlet& InNode);
 
@@ -110,6 +114,19 @@ public:
 	UPROPERTY(EditAnywhere, Category = "Preset")
 	ELKAnimVerletPreset PresetType = ELKAnimVerletPreset::Custom;
 
+	/** Source animation of "Bake To AnimSequence". The result is created next to it with the _AnimVerlet suffix. */
+	UPROPERTY(EditAnywhere, Category = "AnimVerlet Tool")
+	class UAnimSequence* BakeSourceSequence = nullptr;
+	/** Fixed simulation and key rate of the bake */
+	UPROPERTY(EditAnywhere, Category = "AnimVerlet Tool", meta = (ClampMin = "1"))
+	int32 BakeFrameRate = 30;
+	/** Seconds simulated over the looping source before the first key */
+	UPROPERTY(EditAnywhere, Category = "AnimVerlet Tool", meta = (ClampMin = "0.0", ForceUnits = "s"))
+	float BakePreRollTime = 1.0f;
+	/** Bake a local space additive on top of the source instead of a full sequence */
+	UPROPERTY(EditAnywhere, Category = "AnimVerlet Tool")
+	bool bBakeAsAdditive = false;
+
 private:
 	FNodeTitleTextTable CachedNodeTitles;
 	mutable TArray<FVector> VertexSpaceCache;
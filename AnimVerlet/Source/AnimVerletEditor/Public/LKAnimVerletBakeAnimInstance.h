@@ -0,0 +1,57 @@
+#pragma once
+#include <Animation/AnimInstance.h>
+#include <Animation/AnimInstanceProxy.h>
+#include "LKAnimNode_AnimVerlet.h"
+#include "LKAnimVerletBakeAnimInstance.generated.h"
+
+class UAnimSequence;
+
+///=========================================================================================================================================
+/// FLKAnimVerletBakeAnimInstanceProxy
+/// Samples the source sequence at SourceTime and runs a copy of the AnimVerlet node on top of it.
+///=========================================================================================================================================
+USTRUCT()
+struct FLKAnimVerletBakeAnimInstanceProxy : public FAnimInstanceProxy
+{
+	GENERATED_BODY()
+
+public:
+	FLKAnimVerletBakeAnimInstanceProxy() = default;
+	FLKAnimVerletBakeAnimInstanceProxy(UAnimInstance* InAnimInstance) : FAnimInstanceProxy(InAnimInstance) {}
+
+	virtual void UpdateAnimationNode(const FAnimationUpdateContext& InContext) override;
+	virtual bool Evaluate(FPoseContext& Output) override;
+
+public:
+	FLKAnimNode_AnimVerlet AnimVerletNode;
+	UAnimSequence* SourceSequence = nullptr;
+	float SourceTime = 0.0f;
+
+private:
+	bool bNodeInitialized = false;
+	uint16 CachedBonesSerialNumber = 0;
+};
+
+///=========================================================================================================================================
+/// ULKAnimVerletBakeAnimInstance
+/// Transient anim instance used by LKAnimVerletBakeUtil. Not meant to be used as an AnimBlueprint parent.
+///=========================================================================================================================================
+UCLASS(Transient, NotBlueprintable)
+class ULKAnimVerletBakeAnimInstance : public UAnimInstance
+{
+	GENERATED_BODY()
+
+public:
+	/// Runtime only features(budget, offscreen, significance, sharing) are disabled on the copied node so every frame is simulated.
+	void SetupBake(const FLKAnimNode_AnimVerlet& InAnimVerletNode, UAnimSequence* InSourceSequence);
+	void SetSourceTime(float InSourceTime);
+
+protected:
+	virtual FAnimInstanceProxy* CreateAnimInstanceProxy() override;
+	virtual void DestroyAnimInstanceProxy(FAnimInstanceProxy* InProxy) override;
+	virtual void NativeUpdateAnimation(float DeltaSeconds) override;
+
+private:
+	UPROPERTY(Transient)
+	UAnimSequence* SourceSequence = nullptr;
+};
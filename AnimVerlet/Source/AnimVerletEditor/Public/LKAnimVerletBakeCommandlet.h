@@ -0,0 +1,26 @@
+#pragma once
+#include <Commandlets/Commandlet.h>
+#include "LKAnimVerletBakeCommandlet.generated.h"
+
+///=========================================================================================================================================
+/// ULKAnimVerletBakeCommandlet
+/// Bakes AnimVerlet node results to AnimSequences on build machines.
+/// UnrealEditor-Cmd <Project> -run=LKAnimVerletBake -AnimBlueprint=/Game/ABP -Source=/Game/Anim_A,/Game/Anim_B [-Mesh=] [-Output=] [-NodeIndex=0]
+///                                                  [-FrameRate=30] [-PreRoll=1.0] [-Additive] -nullrhi
+/// -Mesh defaults to the preview mesh of the AnimBlueprint. -Output is only used with a single source(default: <Source>_AnimVerlet).
+/// -Topology bakes the simulation topology of the node instead(no -Source, default output: TopologyAsset of the node or <ABP>_AnimVerletTopology).
+///=========================================================================================================================================
+UCLASS()
+class ULKAnimVerletBakeCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	ULKAnimVerletBakeCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	int32 BakeTopologyAsset(const FString& Params, const class UAnimBlueprint* InAnimBlueprint, int32 InNodeIndex, 
+							const struct FLKAnimNode_AnimVerlet& InAnimVerletNode, class USkeletalMesh* InSkeletalMesh);
+};
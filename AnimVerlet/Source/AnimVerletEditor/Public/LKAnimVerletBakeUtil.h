@@ -0,0 +1,45 @@
+#pragma once
+#include <CoreMinimal.h>
+
+struct FLKAnimNode_AnimVerlet;
+class UAnimBlueprint;
+class UAnimSequence;
+class USkeletalMesh;
+class ULKAnimGraphNode_AnimVerlet;
+class ULKAnimVerletTopologyAsset;
+
+struct FLKAnimVerletBakeSetting
+{
+	USkeletalMesh* SkeletalMesh = nullptr;
+	UAnimSequence* SourceSequence = nullptr;
+	/// Fixed simulation and key rate
+	int32 FrameRate = 30;
+	/// Seconds simulated over the looping source before the first key so the result starts settled
+	float PreRollTime = 1.0f;
+	/// Write only the difference to the source sequence(local space additive with the source as the base pose)
+	bool bAdditive = false;
+	/// Long package name of the new sequence(e.g. /Game/Characters/Anim_Idle_AnimVerlet)
+	FString OutputPackageName;
+};
+
+///=========================================================================================================================================
+/// LKAnimVerletBakeUtil
+/// Runs a copy of an AnimVerlet node over a source sequence at a fixed rate in a transient world and writes the result to a new sequence.
+/// Does not need a viewport or a renderer, so it runs in commandlets with -nullrhi.
+/// Also bakes the simulation topology of a node to a ULKAnimVerletTopologyAsset with the required bones of LOD 0.
+///=========================================================================================================================================
+class LKAnimVerletBakeUtil
+{
+public:
+	/// Returns the new(unsaved, dirty) sequence or nullptr with OutError.
+	static UAnimSequence* BakeToAnimSequence(const FLKAnimNode_AnimVerlet& InAnimVerletNode, const FLKAnimVerletBakeSetting& InSetting, OUT FText& OutError);
+	/// InNodeIndex counts AnimVerlet nodes over every graph of the blueprint.
+	static const ULKAnimGraphNode_AnimVerlet* FindAnimVerletGraphNode(const UAnimBlueprint* InAnimBlueprint, int32 InNodeIndex);
+	/// Default output: next to the source with the _AnimVerlet suffix
+	static FString MakeDefaultOutputPackageName(const UAnimSequence* InSourceSequence);
+
+	/// Returns the baked(unsaved, dirty) asset or nullptr with OutError. An existing topology asset at InOutputPackageName is baked again in place.
+	static ULKAnimVerletTopologyAsset* BakeTopologyAsset(const FLKAnimNode_AnimVerlet& InAnimVerletNode, USkeletalMesh* InSkeletalMesh, const FString& InOutputPackageName, OUT FText& OutError);
+	/// Default output: next to the AnimBlueprint with the _AnimVerletTopology suffix
+	static FString MakeDefaultTopologyPackageName(const UAnimBlueprint* InAnimBlueprint, int32 InNodeIndex);
+};